@@ -0,0 +1,618 @@
+/*
+  ==============================================================================
+
+    DSPBenchmark.cpp
+    Created: 18 Oct 2026 2:05:12pm
+    Author:  q
+
+    Headless benchmark for the DSP core. Drives HarmonicEngine (the body of
+    ModalShiftAudioProcessor::processBlock) over a sweep of harmonic count,
+    filter order, block size, sample rate and root note, plus a few kernel
+    micro-benchmarks, and prints the results as JSON.
+
+    Every list option takes comma separated values:
+
+      --harmonics 1,8,64,256    --orders 1,2,3,4    --blocks 16,512,4096
+      --rates 44100,192000      --notes 36,60       --modes bandpass,analytic,resonator
+      --threads 0,3             --seconds 0.5       --output results.json
+      --inputs noise,chord      --no-gate           --isa best,sse2,avx2
+      --mix flat,shaped
+      --no-engine               --no-kernels        --trace trace.json
+
+    --inputs picks what the engine is fed: white noise, which has energy in
+    every band, or a chord of the root's 1st, 3rd and 5th harmonics, which
+    leaves most bands silent. --no-gate keeps every harmonic awake, for
+    comparing against HarmonicGate's savings.
+
+    --mix flat leaves every harmonic at unity gain, centred. shaped tilts
+    the series down 3 dB per octave and pans the harmonics alternately left
+    and right, so the cost of HarmonicEngine::setHarmonicMix shows.
+
+    --isa runs everything once per SIMD instruction set: generic, sse2,
+    avx2, avx512 or neon, or best for the one the plugin would pick. Sets
+    the CPU lacks are an error. Every result carries the set it ran with.
+
+    --trace records every engine call as Chrome trace-event JSON, with the
+    case's harmonic count, order and block size on each block.
+
+    Harmonic counts go up to 4096, but only as many as fit below Nyquist are
+    rendered. To see how the engine scales past the usual range, use a low
+    root at a high rate, e.g. --harmonics 512,1024,4096 --notes 0 --rates 192000.
+
+    Metrics per case:
+      ns_per_sample        wall time per sample frame (all channels)
+      realtime_factor      seconds of audio rendered per second of wall time
+      cycles_per_harmonic  TSC cycles per sample, per channel, per rendered
+                           harmonic (null where there is no TSC)
+      stage_load           CPU time of each engine stage as a fraction of the
+                           audio rendered; only when built with
+                           MODALSHIFT_PROFILE_STAGES
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Source/DSP/BandpassCoefficients.h"
+#include "../Source/DSP/BiquadBank.h"
+#include "../Source/DSP/FrequencyShifter.h"
+#include "../Source/DSP/HarmonicEngine.h"
+#include "../Source/DSP/HilbertProcessor.h"
+#include "../Source/DSP/PhasorBank.h"
+#include "../Source/DSP/SIMDKernels.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#if JUCE_INTEL
+ #include <x86intrin.h>
+#endif
+
+namespace
+{
+
+// MAX_HARMONICS in Params.h
+constexpr int maxHarmonics = 4096;
+constexpr int numChannels = 2;
+
+//==============================================================================
+struct Options
+{
+    std::vector<int> harmonics { 1, 4, 16, 64, 256 };
+    std::vector<int> orders { 1, 2, 3, 4 };
+    std::vector<int> blockSizes { 16, 128, 512, 4096 };
+    std::vector<int> sampleRates { 44100, 48000, 96000, 192000 };
+    std::vector<int> rootNotes { 28, 45, 69 };
+    std::vector<int> threads { 0 };
+    std::vector<std::string> modes { "bandpass" };
+    std::vector<std::string> inputs { "noise" };
+    std::vector<std::string> mixes { "flat" };
+    std::vector<std::string> instructionSets { "best" };
+    double seconds = 0.5;
+    bool runEngine = true, runKernels = true, gate = true;
+    std::string outputPath, tracePath;
+};
+
+std::vector<std::string> split(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (! item.empty())
+            items.push_back(item);
+    return items;
+}
+
+std::vector<int> splitInts(const std::string& text)
+{
+    std::vector<int> values;
+    for (const auto& item : split(text))
+        values.push_back(std::stoi(item));
+    return values;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const auto hasValue = i + 1 < argc;
+
+        if (arg == "--no-engine")                   options.runEngine = false;
+        else if (arg == "--no-kernels")             options.runKernels = false;
+        else if (arg == "--no-gate")                options.gate = false;
+        else if (! hasValue)                        return false;
+        else if (arg == "--harmonics")              options.harmonics = splitInts(argv[++i]);
+        else if (arg == "--orders")                 options.orders = splitInts(argv[++i]);
+        else if (arg == "--blocks")                 options.blockSizes = splitInts(argv[++i]);
+        else if (arg == "--rates")                  options.sampleRates = splitInts(argv[++i]);
+        else if (arg == "--notes")                  options.rootNotes = splitInts(argv[++i]);
+        else if (arg == "--threads")                options.threads = splitInts(argv[++i]);
+        else if (arg == "--modes")                  options.modes = split(argv[++i]);
+        else if (arg == "--inputs")                 options.inputs = split(argv[++i]);
+        else if (arg == "--mix")                    options.mixes = split(argv[++i]);
+        else if (arg == "--isa")                    options.instructionSets = split(argv[++i]);
+        else if (arg == "--seconds")                options.seconds = std::stod(argv[++i]);
+        else if (arg == "--output")                 options.outputPath = argv[++i];
+        else if (arg == "--trace")                  options.tracePath = argv[++i];
+        else                                        return false;
+    }
+    return true;
+}
+
+bool parseMode(const std::string& name, xynth::HarmonicEngine::Mode& mode)
+{
+    using Mode = xynth::HarmonicEngine::Mode;
+    if (name == "bandpass")         mode = Mode::PerHarmonicHilbert;
+    else if (name == "analytic")    mode = Mode::SharedAnalytic;
+    else if (name == "resonator")   mode = Mode::ComplexResonator;
+    else                            return false;
+    return true;
+}
+
+//==============================================================================
+// Wall clock plus the TSC where there is one
+struct Stopwatch
+{
+    void start() noexcept
+    {
+        startCycles = readCycles();
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    void stop() noexcept
+    {
+        const auto endTime = std::chrono::steady_clock::now();
+        cycles = static_cast<double>(readCycles() - startCycles);
+        nanoseconds = std::chrono::duration<double, std::nano>(endTime - startTime).count();
+    }
+
+    static uint64_t readCycles() noexcept
+    {
+       #if JUCE_INTEL
+        return __rdtsc();
+       #else
+        return 0;
+       #endif
+    }
+
+    static constexpr bool hasCycles() noexcept
+    {
+       #if JUCE_INTEL
+        return true;
+       #else
+        return false;
+       #endif
+    }
+
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t startCycles = 0;
+    double nanoseconds = 0.0, cycles = 0.0;
+};
+
+// Keeps the compiler from discarding the rendered audio
+float checksum = 0.f;
+
+std::vector<float> makeNoise(int numSamples)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> distribution(-0.5f, 0.5f);
+    std::vector<float> noise(static_cast<size_t>(numSamples));
+    for (auto& sample : noise)
+        sample = distribution(rng);
+    return noise;
+}
+
+// A few of the root's harmonics, each a whole number of cycles long so the
+// buffer loops without a click
+std::vector<float> makeChord(int numSamples, double sampleRate, float rootFrequency)
+{
+    std::vector<float> chord(static_cast<size_t>(numSamples), 0.f);
+    for (const auto harmonic : { 1, 3, 5 })
+    {
+        const auto cycles = std::round(rootFrequency * harmonic * numSamples / sampleRate);
+        const auto step = juce::MathConstants<double>::twoPi * cycles / numSamples;
+        for (int i = 0; i < numSamples; ++i)
+            chord[static_cast<size_t>(i)] += static_cast<float>(0.15 * std::sin(step * i));
+    }
+    return chord;
+}
+
+std::string number(double value)
+{
+    if (! std::isfinite(value))
+        return "null";
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6g", value);
+    return text;
+}
+
+//==============================================================================
+struct EngineCase
+{
+    std::string modeName, inputName, mixName;
+    xynth::HarmonicEngine::Mode mode;
+    int harmonics, order, blockSize, sampleRate, rootNote, threads;
+    bool gate;
+};
+
+std::string runEngineCase(const EngineCase& c, double seconds, xynth::BlockTracer* tracer)
+{
+    const auto rootFrequency = 440.f * std::pow(2.f, static_cast<float>(c.rootNote - 69) / 12.f);
+
+    juce::dsp::ProcessSpec spec { static_cast<double>(c.sampleRate), static_cast<juce::uint32>(c.blockSize),
+                                  static_cast<juce::uint32>(numChannels) };
+    xynth::HarmonicEngine engine;
+    engine.prepare(spec, c.harmonics);
+    engine.setMode(c.mode);
+    engine.setNumWorkerThreads(c.threads);
+    engine.setTracer(tracer);
+    if (! c.gate)
+        engine.setSleepThreshold(-std::numeric_limits<float>::infinity());
+
+    // Spread the shifts so no two harmonics share an oscillator frequency
+    for (int harmonic = 0; harmonic < c.harmonics; ++harmonic)
+        engine.setShiftFrequency(harmonic, 3.f + 1.5f * static_cast<float>(harmonic));
+
+    if (c.mixName == "shaped")
+        for (int harmonic = 0; harmonic < c.harmonics; ++harmonic)
+            engine.setHarmonicMix(harmonic, 1.f / std::sqrt(static_cast<float>(harmonic + 1)), harmonic % 2 == 0 ? -0.5f : 0.5f);
+
+    const auto effectiveHarmonics = engine.getNumHarmonicsBelowNyquist(rootFrequency, c.harmonics);
+    const auto numBlocks = juce::jmax(1, static_cast<int>(seconds * c.sampleRate) / c.blockSize);
+    const auto input = c.inputName == "chord" ? makeChord(c.blockSize * 16, c.sampleRate, rootFrequency)
+                                              : makeNoise(c.blockSize * 16);
+
+    juce::AudioBuffer<float> buffer(numChannels, c.blockSize);
+    auto renderBlock = [&](int blockIndex)
+    {
+        // Refill from the input so the filters never settle into silence
+        const auto* source = input.data() + (blockIndex % 16) * c.blockSize;
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::copy(buffer.getWritePointer(channel), source, c.blockSize);
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        engine.process(block, rootFrequency, 2.66f, c.harmonics, c.order);
+    };
+
+    // Warm up caches, coefficients and worker threads
+    for (int i = 0; i < juce::jmin(numBlocks, 8); ++i)
+        renderBlock(i);
+    engine.getStageProfiler().collect();
+
+    Stopwatch stopwatch;
+    stopwatch.start();
+    for (int i = 0; i < numBlocks; ++i)
+        renderBlock(i);
+    stopwatch.stop();
+    const auto stages = engine.getStageProfiler().collect();
+
+    checksum += buffer.getReadPointer(0)[c.blockSize - 1];
+
+    const auto numFrames = static_cast<double>(numBlocks) * c.blockSize;
+    const auto nsPerSample = stopwatch.nanoseconds / numFrames;
+    const auto realtimeFactor = (numFrames / c.sampleRate) / (stopwatch.nanoseconds * 1.0e-9);
+    const auto cyclesPerHarmonic = Stopwatch::hasCycles() && effectiveHarmonics > 0
+                                 ? stopwatch.cycles / (numFrames * numChannels * effectiveHarmonics)
+                                 : std::numeric_limits<double>::quiet_NaN();
+
+    std::ostringstream json;
+    json << "{\"isa\": \"" << xynth::SIMDKernels::get().name << "\""
+         << ", \"mode\": \"" << c.modeName << "\""
+         << ", \"input\": \"" << c.inputName << "\""
+         << ", \"mix\": \"" << c.mixName << "\""
+         << ", \"gate\": " << (c.gate ? "true" : "false")
+         << ", \"harmonics\": " << c.harmonics
+         << ", \"effective_harmonics\": " << effectiveHarmonics
+         << ", \"order\": " << c.order
+         << ", \"block_size\": " << c.blockSize
+         << ", \"sample_rate\": " << c.sampleRate
+         << ", \"root_note\": " << c.rootNote
+         << ", \"root_hz\": " << number(rootFrequency)
+         << ", \"threads\": " << c.threads
+         << ", \"ns_per_sample\": " << number(nsPerSample)
+         << ", \"realtime_factor\": " << number(realtimeFactor)
+         << ", \"cycles_per_harmonic\": " << number(cyclesPerHarmonic);
+
+    if (xynth::StageProfiler::enabled)
+    {
+        json << ", \"stage_load\": {";
+        for (int stage = 0; stage < xynth::StageProfiler::numStages; ++stage)
+        {
+            const auto s = static_cast<xynth::StageProfiler::Stage>(stage);
+            json << (stage == 0 ? "\"" : ", \"") << xynth::StageProfiler::getStageName(s) << "\": " << number(stages.getLoad(s));
+        }
+        json << "}";
+    }
+
+    json << "}";
+    return json.str();
+}
+
+//==============================================================================
+// Times numSamples worth of a kernel, called in blocks of blockSize samples
+template <typename Kernel>
+std::string runKernel(const std::string& name, int numSamples, int blockSize, int numHarmonics, Kernel&& kernel)
+{
+    for (int i = 0; i < 8; ++i)
+        kernel(blockSize);
+
+    Stopwatch stopwatch;
+    stopwatch.start();
+    for (int done = 0; done < numSamples; done += blockSize)
+        kernel(blockSize);
+    stopwatch.stop();
+
+    const auto numCalls = static_cast<double>((numSamples + blockSize - 1) / blockSize) * blockSize;
+    const auto cyclesPerHarmonic = Stopwatch::hasCycles()
+                                 ? stopwatch.cycles / (numCalls * numHarmonics)
+                                 : std::numeric_limits<double>::quiet_NaN();
+
+    std::ostringstream json;
+    json << "{\"isa\": \"" << xynth::SIMDKernels::get().name << "\""
+         << ", \"kernel\": \"" << name << "\""
+         << ", \"harmonics\": " << numHarmonics
+         << ", \"block_size\": " << blockSize
+         << ", \"ns_per_sample\": " << number(stopwatch.nanoseconds / numCalls)
+         << ", \"cycles_per_harmonic\": " << number(cyclesPerHarmonic) << "}";
+    return json.str();
+}
+
+std::vector<std::string> runKernels(double seconds)
+{
+    constexpr int blockSize = xynth::HarmonicEngine::tileSize;
+    constexpr int numHarmonics = 64;
+    constexpr double sampleRate = 48000.0;
+    const auto numSamples = juce::jmax(blockSize, static_cast<int>(seconds * sampleRate));
+    const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 1 };
+
+    const auto noise = makeNoise(blockSize);
+    std::vector<xynth::HilbertProcessor::Complex> complexOut(static_cast<size_t>(blockSize));
+    std::vector<std::string> results;
+
+    xynth::HilbertProcessor hilbert;
+    hilbert.prepare(spec);
+
+    results.push_back(runKernel("hilbert_process_sample", numSamples, blockSize, 1, [&](int n)
+    {
+        for (int i = 0; i < n; ++i)
+            complexOut[static_cast<size_t>(i)] = hilbert.processSample(noise[static_cast<size_t>(i)], 0);
+        checksum += complexOut[0].real();
+    }));
+
+    results.push_back(runKernel("hilbert_process_block", numSamples, blockSize, 1, [&](int n)
+    {
+        hilbert.processBlock(noise.data(), complexOut.data(), n, 0);
+        checksum += complexOut[0].real();
+    }));
+
+    // Heterodyne oscillators: the old per-sample std::polar against the phasor bank
+    std::vector<float> phases(numHarmonics, 0.f), deltas(numHarmonics);
+    for (int h = 0; h < numHarmonics; ++h)
+        deltas[static_cast<size_t>(h)] = juce::MathConstants<float>::twoPi * (3.f + 1.5f * h) / static_cast<float>(sampleRate);
+
+    juce::AudioBuffer<float> phasorReal(numHarmonics, blockSize), phasorImag(numHarmonics, blockSize);
+    auto* const* realRows = phasorReal.getArrayOfWritePointers();
+    auto* const* imagRows = phasorImag.getArrayOfWritePointers();
+
+    results.push_back(runKernel("std_polar", numSamples, blockSize, numHarmonics, [&](int n)
+    {
+        for (int h = 0; h < numHarmonics; ++h)
+        {
+            auto phase = phases[static_cast<size_t>(h)];
+            for (int i = 0; i < n; ++i)
+            {
+                const auto phasor = std::polar(1.f, phase);
+                realRows[h][i] = phasor.real();
+                imagRows[h][i] = phasor.imag();
+                phase += deltas[static_cast<size_t>(h)];
+            }
+            phases[static_cast<size_t>(h)] = std::fmod(phase, juce::MathConstants<float>::twoPi);
+        }
+        checksum += realRows[0][0];
+    }));
+
+    xynth::PhasorBank phasorBank;
+    phasorBank.prepare(numHarmonics, sampleRate);
+    for (int h = 0; h < numHarmonics; ++h)
+        phasorBank.setFrequency(h, 3.f + 1.5f * h);
+
+    results.push_back(runKernel("phasor_bank", numSamples, blockSize, numHarmonics, [&](int n)
+    {
+        phasorBank.process(realRows, imagRows, n, 0, numHarmonics);
+        checksum += realRows[0][0];
+    }));
+
+    // A fourth-order cascade per harmonic, as the engine's band filters run at most
+    xynth::BandpassCoefficients coefficients;
+    coefficients.prepare(numHarmonics, sampleRate);
+    xynth::StateArena arena;
+    xynth::BiquadBank biquadBank;
+    biquadBank.prepare(numHarmonics, 1, arena);
+    arena.allocate();
+    for (int h = 0; h < numHarmonics; ++h)
+    {
+        coefficients.setBandPass(h, 110.f * static_cast<float>(h + 1), 10.f);
+        biquadBank.setCoefficients(h, coefficients.getRawCoefficients(h));
+    }
+
+    results.push_back(runKernel("biquad_bank", numSamples, blockSize, numHarmonics, [&](int n)
+    {
+        biquadBank.process(noise.data(), realRows, n, 0, 0, numHarmonics, xynth::BiquadBank::maxStages);
+        checksum += realRows[0][0];
+    }));
+
+    // One shifter per harmonic, as the PerHarmonicHilbert engine mode runs them
+    std::vector<xynth::FrequencyShifter> shifters(numHarmonics);
+    for (auto& shifter : shifters)
+        shifter.prepare(spec);
+
+    results.push_back(runKernel("frequency_shifter", numSamples, blockSize, numHarmonics, [&](int n)
+    {
+        std::fill(complexOut.begin(), complexOut.end(), xynth::HilbertProcessor::Complex());
+        for (int h = 0; h < numHarmonics; ++h)
+            shifters[static_cast<size_t>(h)].process(noise.data(), realRows[h], imagRows[h], complexOut.data(), n);
+        checksum += complexOut[0].real();
+    }));
+
+    return results;
+}
+
+//==============================================================================
+void writeList(std::ostream& out, const char* name, const std::vector<std::string>& items, bool last)
+{
+    out << "  \"" << name << "\": [";
+    for (size_t i = 0; i < items.size(); ++i)
+        out << (i == 0 ? "\n    " : ",\n    ") << items[i];
+    out << (items.empty() ? "]" : "\n  ]") << (last ? "\n" : ",\n");
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (! parseOptions(argc, argv, options))
+    {
+        std::cerr << "usage: ModalShiftBenchmark [--harmonics 1,8,...] [--orders 1,...] [--blocks 16,...]\n"
+                     "       [--rates 44100,...] [--notes 36,...] [--modes bandpass,analytic,resonator]\n"
+                     "       [--threads 0,...] [--seconds 0.5] [--output file.json] [--no-engine] [--no-kernels]\n"
+                     "       [--inputs noise,chord] [--no-gate] [--isa best,...] [--trace trace.json]\n"
+                     "       [--mix flat,shaped]\n";
+        return 1;
+    }
+
+    for (const auto& input : options.inputs)
+    {
+        if (input != "noise" && input != "chord")
+        {
+            std::cerr << "unknown input: " << input << "\n";
+            return 1;
+        }
+    }
+
+    for (const auto& mix : options.mixes)
+    {
+        if (mix != "flat" && mix != "shaped")
+        {
+            std::cerr << "unknown mix: " << mix << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<xynth::SIMDKernels::InstructionSet> instructionSets;
+    for (const auto& name : options.instructionSets)
+    {
+        const auto* kernels = name == "best" ? xynth::SIMDKernels::find(xynth::SIMDKernels::getBest())
+                                             : xynth::SIMDKernels::find(name.c_str());
+        if (kernels == nullptr)
+        {
+            std::cerr << "instruction set not available: " << name << "\n";
+            return 1;
+        }
+        instructionSets.push_back(kernels->instructionSet);
+    }
+
+    juce::FloatVectorOperations::disableDenormalisedNumberSupport();
+
+    std::vector<std::string> engineResults, kernelResults;
+
+    std::unique_ptr<xynth::BlockTracer> tracer;
+    if (! options.tracePath.empty())
+        tracer = std::make_unique<xynth::BlockTracer>();
+
+    for (const auto instructionSet : instructionSets)
+    {
+        xynth::SIMDKernels::use(instructionSet);
+
+        if (options.runEngine)
+        {
+            for (const auto& modeName : options.modes)
+            {
+                EngineCase c {};
+                c.modeName = modeName;
+                c.gate = options.gate;
+                if (! parseMode(modeName, c.mode))
+                {
+                    std::cerr << "unknown mode: " << modeName << "\n";
+                    return 1;
+                }
+
+                for (const auto& inputName : options.inputs)
+                    for (const auto& mixName : options.mixes)
+                        for (auto harmonics : options.harmonics)
+                            for (auto order : options.orders)
+                                for (auto blockSize : options.blockSizes)
+                                    for (auto sampleRate : options.sampleRates)
+                                        for (auto rootNote : options.rootNotes)
+                                            for (auto threads : options.threads)
+                                            {
+                                                c.inputName = inputName;
+                                                c.mixName = mixName;
+                                                c.harmonics = juce::jlimit(1, maxHarmonics, harmonics);
+                                                c.order = juce::jlimit(1, xynth::BiquadBank::maxStages, order);
+                                                c.blockSize = juce::jmax(1, blockSize);
+                                                c.sampleRate = sampleRate;
+                                                c.rootNote = rootNote;
+                                                c.threads = juce::jmax(0, threads);
+                                                engineResults.push_back(runEngineCase(c, options.seconds, tracer.get()));
+                                            }
+            }
+        }
+
+        if (options.runKernels)
+            for (auto& result : runKernels(options.seconds))
+                kernelResults.push_back(std::move(result));
+    }
+
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"best_isa\": \"" << xynth::SIMDKernels::find(xynth::SIMDKernels::getBest())->name << "\",\n"
+         << "  \"has_cycle_counter\": " << (Stopwatch::hasCycles() ? "true" : "false") << ",\n"
+         << "  \"seconds_per_case\": " << number(options.seconds) << ",\n"
+         << "  \"checksum\": " << number(checksum) << ",\n";
+    writeList(json, "engine", engineResults, false);
+    writeList(json, "kernels", kernelResults, true);
+    json << "}\n";
+
+    if (options.outputPath.empty())
+    {
+        std::cout << json.str();
+    }
+    else
+    {
+        std::ofstream file(options.outputPath);
+        file << json.str();
+        if (! file)
+        {
+            std::cerr << "could not write " << options.outputPath << "\n";
+            return 1;
+        }
+    }
+
+    if (tracer != nullptr)
+    {
+        juce::MemoryOutputStream trace;
+        tracer->write(trace);
+
+        std::ofstream file(options.tracePath, std::ios::binary);
+        file.write(static_cast<const char*>(trace.getData()), static_cast<std::streamsize>(trace.getDataSize()));
+        if (! file)
+        {
+            std::cerr << "could not write " << options.tracePath << "\n";
+            return 1;
+        }
+
+        if (tracer->hasWrapped())
+            std::cerr << "trace buffer filled up, only the most recent events were kept\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    BandpassCoefficients.cpp
+    Created: 17 Oct 2026 11:48:05am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "BandpassCoefficients.h"
+
+namespace xynth
+{
+
+void BandpassCoefficients::prepare(int maxHarmonics, double newSampleRate)
+{
+    sampleRate = static_cast<float>(newSampleRate);
+    coefficients.assign(static_cast<size_t>(maxHarmonics * numCoefficients), 0.f);
+    frequencies.resize(static_cast<size_t>(maxHarmonics));
+    qs.resize(static_cast<size_t>(maxHarmonics));
+    invalidate();
+}
+
+void BandpassCoefficients::invalidate() noexcept
+{
+    // NaN never compares equal, so every harmonic is recomputed
+    std::fill(frequencies.begin(), frequencies.end(), std::numeric_limits<float>::quiet_NaN());
+    std::fill(qs.begin(), qs.end(), std::numeric_limits<float>::quiet_NaN());
+}
+
+bool BandpassCoefficients::setBandPass(int harmonic, float frequency, float q) noexcept
+{
+    jassert(harmonic < static_cast<int>(frequencies.size()));
+
+    if (frequencies[harmonic] == frequency && qs[harmonic] == q)
+        return false;
+
+    frequencies[harmonic] = frequency;
+    qs[harmonic] = q;
+
+    // Same arithmetic as IIR::Coefficients::makeBandPass, whose a0 is always 1
+    const auto n = 1.f / std::tan(juce::MathConstants<float>::pi * frequency / sampleRate);
+    const auto nSquared = n * n;
+    const auto invQ = 1.f / q;
+    const auto c1 = 1.f / (1.f + invQ * n + nSquared);
+
+    auto* c = coefficients.data() + harmonic * numCoefficients;
+    c[0] = c1 * n * invQ;
+    c[1] = 0.f;
+    c[2] = -c1 * n * invQ;
+    c[3] = c1 * 2.f * (1.f - nSquared);
+    c[4] = c1 * (1.f - invQ * n + nSquared);
+    return true;
+}
+
+} // namespace xynth
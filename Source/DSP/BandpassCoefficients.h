@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    BandpassCoefficients.h
+    Created: 17 Oct 2026 11:48:05am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace xynth
+{
+
+// Computes one bandpass biquad per harmonic into a flat, preallocated array.
+// Matches juce::dsp::IIR::Coefficients<float>::makeBandPass without creating
+// reference-counted coefficient objects, and only recomputes a harmonic when
+// its frequency or Q has changed since the last call.
+class BandpassCoefficients
+{
+public:
+    static constexpr int numCoefficients = 5;
+
+public:
+    BandpassCoefficients() = default;
+
+    void prepare(int maxHarmonics, double sampleRate);
+
+    // Marks every harmonic as stale so the next setBandPass() recomputes it
+    void invalidate() noexcept;
+
+    // Returns true if the coefficients for this harmonic changed
+    bool setBandPass(int harmonic, float frequency, float q) noexcept;
+
+    // b0, b1, b2, a1, a2, normalised by a0
+    const float* getRawCoefficients(int harmonic) const noexcept { return coefficients.data() + harmonic * numCoefficients; }
+
+private:
+    std::vector<float> coefficients, frequencies, qs;
+    float sampleRate = 44100.f;
+
+};
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    BiquadBank.cpp
+    Created: 17 Oct 2026 10:12:40am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "BiquadBank.h"
+
+namespace xynth
+{
+
+void BiquadBank::prepare(int newMaxHarmonics, int newNumChannels, StateArena& arena)
+{
+    // Pad to a whole group of the widest kernel so no group ever reads past the end
+    constexpr int groupWidth = SIMDKernels::maxGroupWidth;
+    maxHarmonics = newMaxHarmonics;
+    numChannels = newNumChannels;
+    stride = (maxHarmonics + groupWidth - 1) / groupWidth * groupWidth;
+
+    storage.calloc(static_cast<size_t>(numCoefficients * stride) + StateArena::alignment / sizeof(float));
+    arrays = juce::snapPointerToAlignment(storage.get(), StateArena::alignment);
+    states = arena.reserve<float>(static_cast<size_t>(numChannels * maxStages * 2 * stride));
+}
+
+void BiquadBank::reset(int startHarmonic, int endHarmonic) noexcept
+{
+    jassert(0 <= startHarmonic && startHarmonic <= endHarmonic && endHarmonic <= maxHarmonics);
+
+    // Each channel, stage and state variable is a row by harmonic, so only
+    // the part of every row for this range is written
+    for (int channel = 0; channel < numChannels; ++channel)
+        for (int stage = 0; stage < maxStages; ++stage)
+            for (int index = 0; index < 2; ++index)
+                juce::FloatVectorOperations::clear(stateArray(channel, stage, index) + startHarmonic, endHarmonic - startHarmonic);
+}
+
+void BiquadBank::setCoefficients(int harmonic, const float* rawCoefficients) noexcept
+{
+    jassert(harmonic < maxHarmonics);
+
+    for (int i = 0; i < numCoefficients; ++i)
+        coefficientArray(i)[harmonic] = rawCoefficients[i];
+}
+
+void BiquadBank::process(const float* input, float* const* outputs, int numSamples,
+                         int channel, int startHarmonic, int endHarmonic, int numStages) noexcept
+{
+    jassert(channel < numChannels);
+    jassert(endHarmonic <= maxHarmonics);
+    jassert(numStages >= 1 && numStages <= maxStages);
+    jassert(startHarmonic % laneWidth == 0);
+
+    SIMDKernels::get().biquadBank(input, outputs, numSamples, coefficientArray(0), stateArray(channel, 0, 0), stride,
+                                  juce::jlimit(1, maxStages, numStages), startHarmonic, endHarmonic);
+}
+
+} // namespace xynth
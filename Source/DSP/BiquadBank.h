@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    BiquadBank.h
+    Created: 17 Oct 2026 10:12:40am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SIMDKernels.h"
+#include "StateArena.h"
+
+namespace xynth
+{
+
+// A bank of biquad cascades, one per harmonic, all fed from the same input.
+// Coefficients and states are stored structure-of-arrays (one float per harmonic)
+// so that neighbouring harmonics can be stepped together in SIMD lanes, by
+// whichever SIMDKernels the CPU runs best. The states live in a StateArena,
+// next to the rest of the engine's.
+// Every stage of a harmonic's cascade shares that harmonic's coefficients.
+// The arithmetic matches juce::dsp::IIR::Filter (transposed direct form II).
+class BiquadBank
+{
+public:
+    // The widest kernel's, which ranges have to start on
+    static constexpr int laneWidth = SIMDKernels::maxLaneWidth;
+    static constexpr int maxStages = 4;
+
+public:
+    BiquadBank() = default;
+
+    // Reserves the filter states in arena, which the caller then allocates
+    void prepare(int maxHarmonics, int numChannels, StateArena& arena);
+    // Clears the states of harmonics [startHarmonic, endHarmonic) on every channel
+    void reset(int startHarmonic, int endHarmonic) noexcept;
+
+    // b0, b1, b2, a1, a2, already normalised by a0
+    void setCoefficients(int harmonic, const float* rawCoefficients) noexcept;
+
+    // Runs the cascades of harmonics [startHarmonic, endHarmonic) over input, writing harmonic h
+    // to outputs[h - startHarmonic], so a range only needs rows for its own harmonics.
+    // startHarmonic must be a multiple of laneWidth. Only the state of those
+    // harmonics is touched, so disjoint ranges can run on different threads.
+    void process(const float* input, float* const* outputs, int numSamples,
+                 int channel, int startHarmonic, int endHarmonic, int numStages) noexcept;
+
+    int getMaxHarmonics() const noexcept { return maxHarmonics; }
+
+private:
+    float* coefficientArray(int index) const noexcept { return arrays + index * stride; }
+    // Laid out for maxStages whatever the order, so the order can change between blocks
+    float* stateArray(int channel, int stage, int index) const noexcept
+    {
+        return states.get() + ((channel * maxStages + stage) * 2 + index) * stride;
+    }
+
+    static constexpr int numCoefficients = 5;
+
+    juce::HeapBlock<float> storage;
+    float* arrays = nullptr;
+    StateArena::Region<float> states;
+    int stride = 0, maxHarmonics = 0, numChannels = 0;
+
+};
+}
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    BlockTracer.cpp
+    Created: 19 Oct 2026 6:38:21pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "BlockTracer.h"
+
+namespace xynth
+{
+
+namespace
+{
+
+// Calls function on the events still in a ring, oldest first
+template <typename Event, typename Function>
+void forEachInRing(const std::vector<Event>& ring, juce::int64 numRecorded, Function&& function)
+{
+    const auto size = static_cast<juce::int64>(ring.size());
+    for (auto i = juce::jmax<juce::int64>(0, numRecorded - size); i < numRecorded; ++i)
+        function(ring[static_cast<size_t>(i & (size - 1))]);
+}
+
+} // namespace
+
+BlockTracer::Span::Span(BlockTracer* t, const char* n, int i) noexcept
+    : tracer(t), name(n), index(i)
+{
+    if (tracer != nullptr)
+        start = getTicks();
+}
+
+void BlockTracer::Span::end() noexcept
+{
+    if (tracer == nullptr)
+        return;
+
+    tracer->addSpan(name, index, start, getTicks());
+    tracer = nullptr;
+}
+
+//==============================================================================
+BlockTracer::BlockTracer(int maxSpans)
+    : startTicks(getTicks())
+{
+    // Powers of two, so a slot is the event count masked
+    spans.resize(static_cast<size_t>(juce::nextPowerOfTwo(juce::jmax(maxSpans, 16))));
+    blocks.resize(spans.size() / 16);
+}
+
+void BlockTracer::addSpan(const char* name, int index, juce::int64 start, juce::int64 end) noexcept
+{
+    const auto slot = numSpans.fetch_add(1, std::memory_order_relaxed) & static_cast<juce::int64>(spans.size() - 1);
+    spans[static_cast<size_t>(slot)] = { name, start, end, getThreadIndex(), index };
+}
+
+void BlockTracer::addBlock(const BlockInfo& info, juce::int64 start, juce::int64 end) noexcept
+{
+    const auto slot = numBlocks.fetch_add(1, std::memory_order_relaxed) & static_cast<juce::int64>(blocks.size() - 1);
+    blocks[static_cast<size_t>(slot)] = { info, start, end, getThreadIndex() };
+}
+
+bool BlockTracer::hasWrapped() const noexcept
+{
+    return getNumSpansRecorded() > static_cast<juce::int64>(spans.size())
+        || getNumBlocksRecorded() > static_cast<juce::int64>(blocks.size());
+}
+
+int BlockTracer::getThreadIndex() noexcept
+{
+    static std::atomic<int> nextIndex { 0 };
+    thread_local const int index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+void BlockTracer::write(juce::OutputStream& stream) const
+{
+    const auto microsecondsPerTick = 1.0e6 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    auto first = true;
+    juce::SortedSet<int> threads;
+
+    const auto startEvent = [&]
+    {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    // Complete ("X") events, times in microseconds since the tracer was created
+    const auto writeEvent = [&](const char* name, int thread, juce::int64 start, juce::int64 end)
+    {
+        startEvent();
+        stream << "{\"name\": \"" << name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << thread
+               << ", \"ts\": " << juce::String(static_cast<double>(start - startTicks) * microsecondsPerTick, 3)
+               << ", \"dur\": " << juce::String(static_cast<double>(end - start) * microsecondsPerTick, 3);
+        threads.add(thread);
+    };
+
+    stream << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+    forEachInRing(blocks, getNumBlocksRecorded(), [&](const BlockEvent& block)
+    {
+        writeEvent("process", block.thread, block.start, block.end);
+
+        const auto& info = block.info;
+        stream << ", \"args\": {\"samples\": " << info.numSamples
+               << ", \"harmonics\": " << info.numHarmonics
+               << ", \"order\": " << info.numStages
+               << ", \"mode\": " << info.mode
+               << ", \"retuned\": " << info.numRetuned
+               << ", \"awake\": " << info.numAwake
+               << ", \"idle\": " << (info.idle ? "true" : "false");
+
+        if (StageProfiler::enabled)
+            for (int stage = 0; stage < StageProfiler::numStages; ++stage)
+                stream << ", \"" << StageProfiler::getStageName(static_cast<StageProfiler::Stage>(stage)) << "_us\": "
+                       << juce::String(info.stageSeconds[static_cast<size_t>(stage)] * 1.0e6, 3);
+
+        stream << "}}";
+    });
+
+    forEachInRing(spans, getNumSpansRecorded(), [&](const SpanEvent& span)
+    {
+        writeEvent(span.name, span.thread, span.start, span.end);
+
+        if (span.index >= 0)
+            stream << ", \"args\": {\"index\": " << span.index << "}";
+
+        stream << "}";
+    });
+
+    for (const auto thread : threads)
+    {
+        startEvent();
+        stream << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread
+               << ", \"args\": {\"name\": \"thread " << thread << "\"}}";
+    }
+
+    stream << "\n]}\n";
+}
+
+} // namespace xynth
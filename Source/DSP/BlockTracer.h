@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    BlockTracer.h
+    Created: 19 Oct 2026 6:38:21pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StageProfiler.h"
+
+namespace xynth
+{
+
+// Records a timeline of HarmonicEngine calls for offline profiling: one event
+// per process() call with its settings, and spans for the coefficient update,
+// each chunk's input, harmonic groups and mix-down on whichever thread ran them.
+// write() turns it into Chrome trace-event JSON, for chrome://tracing or Perfetto.
+//
+// Events go into rings preallocated in the constructor, claimed with one atomic
+// each, so recording never locks or allocates. Once a ring is full the oldest
+// events are overwritten. Only write() once nothing is recording any more.
+class BlockTracer
+{
+public:
+    struct BlockInfo
+    {
+        int numSamples = 0, numHarmonics = 0, numStages = 0, mode = 0;
+        // Harmonics whose filter coefficients had to be recomputed, i.e. parameter changes
+        int numRetuned = 0;
+        // Harmonics, summed over channels, that the gate had awake at the end of the block
+        int numAwake = 0;
+        // Silent for longer than the tail, so nothing was processed
+        bool idle = false;
+        // CPU time per stage, only filled in when built with MODALSHIFT_PROFILE_STAGES
+        std::array<float, StageProfiler::numStages> stageSeconds {};
+    };
+
+    // Records the time from construction to destruction (or end()) as a span.
+    // Does nothing at all if the tracer is null.
+    class Span
+    {
+    public:
+        Span(BlockTracer* t, const char* name, int index = -1) noexcept;
+        ~Span() { end(); }
+
+        void end() noexcept;
+
+    private:
+        BlockTracer* tracer;
+        const char* name;
+        int index;
+        juce::int64 start = 0;
+
+        JUCE_DECLARE_NON_COPYABLE(Span)
+    };
+
+public:
+    // Room for maxSpans spans; blocks get a sixteenth of that
+    explicit BlockTracer(int maxSpans = 1 << 20);
+
+    void addSpan(const char* name, int index, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+    void addBlock(const BlockInfo& info, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+
+    // Events recorded so far, including any that have been overwritten
+    juce::int64 getNumSpansRecorded() const noexcept { return numSpans.load(std::memory_order_relaxed); }
+    juce::int64 getNumBlocksRecorded() const noexcept { return numBlocks.load(std::memory_order_relaxed); }
+    bool hasWrapped() const noexcept;
+
+    void write(juce::OutputStream& stream) const;
+
+    static juce::int64 getTicks() noexcept { return juce::Time::getHighResolutionTicks(); }
+
+private:
+    struct SpanEvent
+    {
+        const char* name;
+        juce::int64 start, end;
+        int thread, index;
+    };
+
+    struct BlockEvent
+    {
+        BlockInfo info;
+        juce::int64 start, end;
+        int thread;
+    };
+
+    // Small, stable numbers for the threads that record, in order of first use
+    static int getThreadIndex() noexcept;
+
+    const juce::int64 startTicks;
+    std::vector<SpanEvent> spans;
+    std::vector<BlockEvent> blocks;
+    std::atomic<juce::int64> numSpans { 0 }, numBlocks { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(BlockTracer)
+};
+}
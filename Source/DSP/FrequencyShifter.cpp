@@ -13,47 +13,38 @@
 namespace xynth
 {
 
-FrequencyShifter::FrequencyShifter(std::atomic<float>& f) : frequencyParameter(f)
-{}
-
 void FrequencyShifter::prepare(const juce::dsp::ProcessSpec& spec) noexcept
 {
     hilbertProcessor.prepare(spec);
-    antialiasingProcessor.prepare(spec, 1.f);
-    radiansCoefficient = juce::MathConstants<float>::twoPi / (float)spec.sampleRate;
 }
 
-void FrequencyShifter::process(juce::dsp::ProcessContextReplacing<float>& context, bool antiAlias) noexcept
+void FrequencyShifter::process(const float* input, const float* phasorReal, const float* phasorImag,
+                               HilbertProcessor::Complex* output, int numSamples) noexcept
 {
-    const auto& inputBlock = context.getInputBlock();
-    auto& outputBlock = context.getOutputBlock();
-
-    const float frequency = frequencyParameter.load(std::memory_order_relaxed);
-    const float phaseDelta = frequency * radiansCoefficient;
-    const float startPhase = phase;
+    std::array<float, chunkSize> filteredReal, filteredImag;
 
-    for (int channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+    for (int start = 0; start < numSamples; start += chunkSize)
     {
-        const auto* inputPointer = inputBlock.getChannelPointer(channel);
-        auto* outputPointer = outputBlock.getChannelPointer(channel);
-        phase = startPhase;
-
-        for (int i = 0; i < inputBlock.getNumSamples(); ++i)
-        {
-            // Hilbert Filter
-            const auto filteredSample = hilbertProcessor.processSample(inputPointer[i], channel);
-            
-            // Heterodyne/ringmod
-            const auto phaser = std::polar(1.f, phase);
-
-            // Anti-alias
-            const auto output = antialiasingProcessor.processSample(filteredSample * phaser, channel);
-            outputPointer[i] = output.real();
-            phase += phaseDelta;
-        }
+        const auto numChunkSamples = juce::jmin(chunkSize, numSamples - start);
+
+        analyse(input + start, filteredReal.data(), filteredImag.data(), numChunkSamples);
+        process(filteredReal.data(), filteredImag.data(), phasorReal + start, phasorImag + start, output + start, numChunkSamples);
     }
+}
 
-    phase = std::fmod(phase, juce::MathConstants<float>::twoPi);
+void FrequencyShifter::analyse(const float* input, float* analyticReal, float* analyticImag, int numSamples) noexcept
+{
+    // Hilbert Filter
+    hilbertProcessor.processBlock(input, analyticReal, analyticImag, numSamples, 0);
+}
+
+void FrequencyShifter::process(const float* inputReal, const float* inputImag, const float* phasorReal, const float* phasorImag,
+                               HilbertProcessor::Complex* output, int numSamples) noexcept
+{
+    // Heterodyne/ringmod
+    constexpr float unity = 1.f;
+    SIMDKernels::get().heterodyne(inputReal, inputImag, phasorReal, phasorImag,
+                                  reinterpret_cast<float*>(output), 0, &unity, 1, numSamples);
 }
 //
 //void FrequencyShifter::process(juce::dsp::ProcessContextReplacing<float>& context, bool antiAlias) noexcept
@@ -147,8 +138,6 @@ void FrequencyShifter::process(juce::dsp::ProcessContextReplacing<float>& contex
 void FrequencyShifter::reset() noexcept
 {
     hilbertProcessor.reset();
-    antialiasingProcessor.reset();
-    phase = 0.f;
 }
 
 } // namespace xynth
@@ -19,21 +19,32 @@ namespace xynth
 class FrequencyShifter
 {
 public:
-    FrequencyShifter(std::atomic<float>& frequencyParameter);
+    FrequencyShifter() = default;
 
     void prepare(const juce::dsp::ProcessSpec& spec) noexcept;
-    void process(juce::dsp::ProcessContextReplacing<float>& context, bool antiAlias) noexcept;
+
+    // Shifts a block of one channel and adds the heterodyned analytic signal to output.
+    // The oscillator comes from outside (see PhasorBank) so both channels of a harmonic
+    // can share it. The result still needs anti-aliasing, which is linear and the same
+    // for every harmonic, so callers sum their shifters first and run it once.
+    void process(const float* input, const float* phasorReal, const float* phasorImag,
+                 HilbertProcessor::Complex* output, int numSamples) noexcept;
+    // As above, for an input that is already analytic
+    static void process(const float* inputReal, const float* inputImag, const float* phasorReal, const float* phasorImag,
+                        HilbertProcessor::Complex* output, int numSamples) noexcept;
+
+    // The Hilbert half of the first process(), for callers that want to time it apart. The
+    // second process() is the other half.
+    void analyse(const float* input, float* analyticReal, float* analyticImag, int numSamples) noexcept;
 
     void reset() noexcept;
 
 private:
-    using HilbertIIR = signalsmith::hilbert::HilbertIIR<float>;
-    HilbertProcessor hilbertProcessor, antialiasingProcessor;
+    // Stack scratch for the Hilbert output, so shifters carry no block-sized buffers
+    static constexpr int chunkSize = 64;
 
-private:
-    std::atomic<float>& frequencyParameter;
-    float radiansCoefficient = 0.f;
-    float phase = 0.f;
+    using HilbertIIR = signalsmith::hilbert::HilbertIIR<float>;
+    HilbertProcessor hilbertProcessor;
 
 };
 }
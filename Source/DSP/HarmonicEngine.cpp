@@ -0,0 +1,462 @@
+/*
+  ==============================================================================
+
+    HarmonicEngine.cpp
+    Created: 17 Oct 2026 1:20:31pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "HarmonicEngine.h"
+
+namespace xynth
+{
+
+static_assert(HarmonicEngine::harmonicsPerGroup % BiquadBank::laneWidth == 0,
+              "groups must start on a SIMD lane boundary");
+static_assert(HarmonicEngine::chunkSize % HarmonicEngine::tileSize == 0,
+              "chunks must be whole tiles");
+
+void HarmonicEngine::prepare(const juce::dsp::ProcessSpec& newSpec, int newMaxHarmonics)
+{
+    // Hosts call prepareToPlay on things like every transport start, mostly with
+    // nothing changed
+    if (maxHarmonics > 0 && newMaxHarmonics == maxHarmonics && newSpec.sampleRate == spec.sampleRate
+        && newSpec.maximumBlockSize == spec.maximumBlockSize && newSpec.numChannels == spec.numChannels)
+        return;
+
+    spec = newSpec;
+    maxHarmonics = newMaxHarmonics;
+    numChannels = static_cast<int>(spec.numChannels);
+
+    bandpassCoefficients.prepare(maxHarmonics, spec.sampleRate);
+
+    stateArena.clear();
+    // Two state sets per channel, for the real and imaginary parts in SharedAnalytic mode
+    filterBank.prepare(maxHarmonics, numChannels * 2, stateArena);
+    resonatorBank.prepare(maxHarmonics, numChannels, spec.sampleRate, stateArena);
+    gate.prepare(maxHarmonics, numChannels, spec.sampleRate, stateArena);
+    hilbertStates = stateArena.reserve<HilbertProcessor::State>(static_cast<size_t>(numChannels * maxHarmonics));
+    stateArena.allocate();
+
+    // No channels of its own, the states are hilbertStates
+    auto harmonicSpec = spec;
+    harmonicSpec.maximumBlockSize = tileSize;
+    harmonicSpec.numChannels = 0;
+    harmonicHilbertProcessor.prepare(harmonicSpec);
+
+    phasorBank.prepare(maxHarmonics, spec.sampleRate);
+    mixGains.assign(static_cast<size_t>(maxHarmonics * numChannels * numChannels), 0.f);
+    for (int harmonic = 0; harmonic < maxHarmonics; ++harmonic)
+        setHarmonicMix(harmonic, 1.f);
+
+    profiler.prepare(spec.sampleRate);
+    inputHilbertProcessor.prepare(spec);
+    antialiasingProcessor.prepare(spec, 1.f);
+    // The harmonics' and the input's Hilbert filters all share these poles
+    hilbertTailSamples = antialiasingProcessor.getTailSamples(-silenceDb);
+    silentSamples = idleSamples = 0;
+    idle = false;
+    activeHarmonics = 0;
+
+    // Scratch, written before it's read, so none of it needs clearing
+    const auto maxGroups = (maxHarmonics + harmonicsPerGroup - 1) / harmonicsPerGroup;
+    inputChunk.setSize(numChannels * 2, chunkSize);
+    partials.malloc(static_cast<size_t>(maxGroups * numChannels * chunkSize));
+
+    prepareGroupTiles();
+    // No reset(): the arena comes back zeroed, and everything else resets in its own prepare()
+}
+
+void HarmonicEngine::reset() noexcept
+{
+    resetFilters();
+    phasorBank.reset();
+    // Or the next sound would catch the reset oscillators up on the silence before it
+    silentSamples = idleSamples = 0;
+    idle = false;
+}
+
+void HarmonicEngine::resetFilters() noexcept
+{
+    // The band filters, the harmonics' Hilbert filters and the gate, whose
+    // zeroed state has every harmonic asleep. Only what has run holds anything:
+    // the arena is sized for every harmonic prepare() allowed, and most of it
+    // may never have been touched.
+    clearHarmonics(0, activeHarmonics);
+    inputHilbertProcessor.reset();
+    antialiasingProcessor.reset();
+}
+
+void HarmonicEngine::clearHarmonics(int startHarmonic, int endHarmonic) noexcept
+{
+    if (startHarmonic >= endHarmonic)
+        return;
+
+    filterBank.reset(startHarmonic, endHarmonic);
+    resonatorBank.reset(startHarmonic, endHarmonic);
+    gate.reset(startHarmonic, endHarmonic);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        std::fill(&getHilbertState(channel, startHarmonic), &getHilbertState(channel, endHarmonic - 1) + 1, HilbertProcessor::State());
+}
+
+void HarmonicEngine::setNumWorkerThreads(int numThreads)
+{
+    workerPool.setNumWorkers(numThreads);
+    prepareGroupTiles();
+}
+
+void HarmonicEngine::prepareGroupTiles()
+{
+    groupTiles.resize(static_cast<size_t>(workerPool.getNumThreads()));
+
+    // The row pointers are taken after resizing, as moving a buffer may move its channel list
+    for (auto& tile : groupTiles)
+    {
+        tile.buffer.setSize(4 * harmonicsPerGroup, tileSize, false, false, true);
+        auto* const* rows = tile.buffer.getArrayOfWritePointers();
+        tile.harmonicRows = rows;
+        tile.harmonicImagRows = rows + harmonicsPerGroup;
+        tile.phasorRows = rows + 2 * harmonicsPerGroup;
+        tile.phasorImagRows = rows + 3 * harmonicsPerGroup;
+    }
+}
+
+void HarmonicEngine::setMode(Mode newMode) noexcept
+{
+    if (newMode == mode)
+        return;
+
+    mode = newMode;
+    // Not reset(): the oscillators can keep running, and QualityGovernor switches
+    // modes on the audio thread, right after it has measured an overload
+    resetFilters();
+}
+
+void HarmonicEngine::setShiftFrequency(int harmonic, float frequency) noexcept
+{
+    phasorBank.setFrequency(harmonic, frequency);
+}
+
+void HarmonicEngine::setHarmonicMix(int harmonic, float gain, float pan) noexcept
+{
+    jassert(harmonic >= 0 && harmonic < maxHarmonics);
+
+    auto* gains = mixGains.data() + harmonic * numChannels * numChannels;
+    std::fill(gains, gains + numChannels * numChannels, 0.f);
+
+    if (numChannels != 2)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            gains[channel * numChannels + channel] = gain;
+        return;
+    }
+
+    // The channel on the far side from the pan fades out of its own output and
+    // into the other one. Sines both ways, so the ends and the centre are exact.
+    pan = juce::jlimit(-1.f, 1.f, pan);
+    const auto moving = pan < 0.f ? 1 : 0, other = 1 - moving;
+    const auto amount = std::abs(pan);
+
+    gains[moving * 2 + moving] = gain * std::sin((1.f - amount) * juce::MathConstants<float>::halfPi);
+    gains[moving * 2 + other] = gain * std::sin(amount * juce::MathConstants<float>::halfPi);
+    gains[other * 2 + other] = gain;
+}
+
+double HarmonicEngine::getTailSeconds(Mode tailMode, float rootFrequency, float resonance, int numStages) const noexcept
+{
+    const auto sampleRate = spec.sampleRate;
+    const auto frequency = static_cast<double>(rootFrequency);
+    const auto q = static_cast<double>(resonance);
+
+    // Pole radius of the root's band filter, which is the slowest to decay
+    auto radius = std::exp(-juce::MathConstants<double>::pi * frequency / (q * sampleRate));
+    if (tailMode != Mode::ComplexResonator)
+    {
+        // BandpassCoefficients' bilinear bandpass has |pole|^2 = a2
+        const auto n = 1.0 / std::tan(juce::MathConstants<double>::pi * juce::jmin(frequency, 0.49 * sampleRate) / sampleRate);
+        radius = std::sqrt((1.0 - n / q + n * n) / (1.0 + n / q + n * n));
+    }
+
+    // Each stage in the cascade adds its own decay, which errs on the long side
+    const auto stageSamples = -silenceDb / (-20.0 * std::log10(radius));
+    const auto numHilberts = tailMode == Mode::ComplexResonator ? 1 : 2;
+
+    return (stageSamples * juce::jmax(1, numStages) + hilbertTailSamples * numHilberts) / sampleRate;
+}
+
+int HarmonicEngine::getNumHarmonicsBelowNyquist(float rootFrequency, int numHarmonics) const noexcept
+{
+    const auto maxPossibleHarmonics = static_cast<int>(spec.sampleRate / (2.0f * rootFrequency));
+    return juce::jmin(numHarmonics, maxPossibleHarmonics, maxHarmonics);
+}
+
+int HarmonicEngine::updateCoefficients(float rootFrequency, float resonance, int numHarmonics) noexcept
+{
+    int numRetuned = 0;
+
+    for (int harmonic = 0; harmonic < numHarmonics; ++harmonic)
+    {
+        const auto harmonicFreq = rootFrequency * static_cast<float>(harmonic + 1);
+
+        if (mode == Mode::ComplexResonator)
+        {
+            if (resonatorBank.setResonance(harmonic, harmonicFreq, resonance))
+                ++numRetuned;
+        }
+        else if (bandpassCoefficients.setBandPass(harmonic, harmonicFreq, resonance))
+        {
+            filterBank.setCoefficients(harmonic, bandpassCoefficients.getRawCoefficients(harmonic));
+            ++numRetuned;
+        }
+    }
+
+    return numRetuned;
+}
+
+bool HarmonicEngine::skipSilence(juce::dsp::AudioBlock<float>& block, float rootFrequency, float resonance, int numStages) noexcept
+{
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+    // Not Decibels::decibelsToGain, which treats -100 dB as minus infinity
+    const auto floor = std::pow(10.f, silenceDb / 20.f);
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer(channel), numSamples);
+        if (range.getStart() < -floor || range.getEnd() > floor)
+        {
+            // Only the harmonics in use were running when it went idle
+            if (idle)
+                phasorBank.advance(idleSamples, activeHarmonics);
+
+            silentSamples = idleSamples = 0;
+            idle = false;
+            return false;
+        }
+    }
+
+    silentSamples += numSamples;
+
+    if (! idle)
+    {
+        // Go idle once this whole block is past the tail
+        const auto tailSamples = getTailSeconds(mode, rootFrequency, resonance, numStages) * spec.sampleRate;
+        if (static_cast<double>(silentSamples - numSamples) < tailSamples)
+            return false;
+
+        // What's left in the filters is under the floor, so resume from exact zeros.
+        // Only the harmonics in use are cleared, so going idle costs next to nothing.
+        resetFilters();
+        idle = true;
+    }
+
+    idleSamples += numSamples;
+    block.clear();
+    return true;
+}
+
+void HarmonicEngine::traceBlock(juce::int64 startTicks, int numSamples, int numHarmonics, int numStages, int numRetuned) noexcept
+{
+    BlockTracer::BlockInfo info;
+    info.numSamples = numSamples;
+    info.numHarmonics = numHarmonics;
+    info.numStages = numStages;
+    info.mode = static_cast<int>(mode);
+    info.numRetuned = numRetuned;
+    info.idle = idle;
+
+    for (int channel = 0; channel < chunkChannels; ++channel)
+        for (int harmonic = 0; harmonic < numHarmonics; ++harmonic)
+            if (gate.isAwake(channel, harmonic))
+                ++info.numAwake;
+
+    for (int stage = 0; stage < StageProfiler::numStages; ++stage)
+        info.stageSeconds[static_cast<size_t>(stage)] = static_cast<float>(profiler.getLastBlockSeconds(static_cast<StageProfiler::Stage>(stage)));
+
+    tracer->addBlock(info, startTicks, BlockTracer::getTicks());
+}
+
+void HarmonicEngine::process(juce::dsp::AudioBlock<float>& block, float rootFrequency, float resonance,
+                             int numHarmonics, int numStages) noexcept
+{
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+    const auto startTicks = tracer != nullptr ? BlockTracer::getTicks() : 0;
+
+    if (idleWhenSilent && skipSilence(block, rootFrequency, resonance, numStages))
+    {
+        profiler.endBlock(numSamples);
+        if (tracer != nullptr)
+            traceBlock(startTicks, numSamples, 0, numStages, 0);
+        return;
+    }
+
+    StageProfiler::Lap lap(profiler);
+
+    numHarmonics = getNumHarmonicsBelowNyquist(rootFrequency, numHarmonics);
+
+    // Harmonics coming back into use may hold whatever they had when they dropped out
+    if (numHarmonics > activeHarmonics)
+        clearHarmonics(activeHarmonics, numHarmonics);
+    activeHarmonics = numHarmonics;
+    BlockTracer::Span coefficientSpan(tracer, "coefficients");
+    const auto numRetuned = updateCoefficients(rootFrequency, resonance, numHarmonics);
+    coefficientSpan.end();
+    lap.record(StageProfiler::Coefficients);
+
+    chunkHarmonics = numHarmonics;
+    chunkChannels = juce::jmin(static_cast<int>(block.getNumChannels()), numChannels);
+    chunkStages = numStages;
+    const auto numGroups = (numHarmonics + harmonicsPerGroup - 1) / harmonicsPerGroup;
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        chunkSamples = juce::jmin(chunkSize, numSamples - start);
+        BlockTracer::Span inputSpan(tracer, "input");
+
+        // The output aliases the input, so take the chunk before overwriting it
+        for (int channel = 0; channel < chunkChannels; ++channel)
+        {
+            auto* real = inputChunk.getWritePointer(channel * 2);
+            auto* imag = inputChunk.getWritePointer(channel * 2 + 1);
+            juce::FloatVectorOperations::copy(real, block.getChannelPointer(static_cast<size_t>(channel)) + start, chunkSamples);
+
+            if (mode == Mode::SharedAnalytic)
+                inputHilbertProcessor.processBlock(real, real, imag, chunkSamples, channel);
+        }
+        inputSpan.end();
+        lap.record(mode == Mode::SharedAnalytic ? StageProfiler::Hilbert : StageProfiler::MixDown);
+
+        // The tasks time themselves, including the ones this thread picks up
+        BlockTracer::Span harmonicsSpan(tracer, "harmonics");
+        workerPool.run(*this, numGroups);
+        harmonicsSpan.end();
+        lap.restart();
+
+        const BlockTracer::Span mixDownSpan(tracer, "mixdown");
+
+        for (int channel = 0; channel < chunkChannels; ++channel)
+        {
+            // Summing in group order keeps the result independent of the thread count
+            // Complex values go through as pairs of floats
+            SIMDKernels::get().sum(reinterpret_cast<float*>(shiftedChunk.data()), reinterpret_cast<const float*>(getPartial(0, channel)),
+                                   numChannels * chunkSize * 2, numGroups, chunkSamples * 2);
+
+            // One anti-aliasing pass for the whole harmonic sum
+            antialiasingProcessor.processBlock(shiftedChunk.data(), shiftedChunk.data(), chunkSamples, channel);
+
+            auto* output = block.getChannelPointer(static_cast<size_t>(channel)) + start;
+            for (int i = 0; i < chunkSamples; ++i)
+                output[i] = shiftedChunk[i].real();
+        }
+        lap.record(StageProfiler::MixDown);
+    }
+
+    lap.flush();
+    profiler.endBlock(numSamples);
+
+    if (tracer != nullptr)
+        traceBlock(startTicks, numSamples, numHarmonics, numStages, numRetuned);
+}
+
+void HarmonicEngine::runTask(int group, int threadIndex) noexcept
+{
+    auto& tile = groupTiles[static_cast<size_t>(threadIndex)];
+    const BlockTracer::Span span(tracer, "group", group);
+    StageProfiler::Lap lap(profiler);
+
+    for (int channel = 0; channel < chunkChannels; ++channel)
+        std::fill(getPartial(group, channel), getPartial(group, channel) + chunkSamples, HilbertProcessor::Complex());
+    lap.record(StageProfiler::MixDown);
+
+    for (int offset = 0; offset < chunkSamples; offset += tileSize)
+        processGroupTile(group, tile, offset, juce::jmin(tileSize, chunkSamples - offset), lap);
+}
+
+void HarmonicEngine::processGroupTile(int group, GroupTile& tile, int offset, int numTileSamples, StageProfiler::Lap& lap) noexcept
+{
+    // Each group only touches its own harmonics' states, and its thread's rows
+    const auto startHarmonic = group * harmonicsPerGroup;
+    const auto endHarmonic = juce::jmin(startHarmonic + harmonicsPerGroup, chunkHarmonics);
+
+    phasorBank.process(tile.phasorRows, tile.phasorImagRows, numTileSamples, startHarmonic, endHarmonic);
+    lap.record(StageProfiler::Heterodyne);
+
+    for (int channel = 0; channel < chunkChannels; ++channel)
+    {
+        const auto* inputTile = inputChunk.getReadPointer(channel * 2, offset);
+        const auto* inputImagTile = inputChunk.getReadPointer(channel * 2 + 1, offset);
+        const auto inputPower = HarmonicGate::getPower(inputTile, numTileSamples);
+
+        if (mode == Mode::SharedAnalytic)
+        {
+            // Real coefficients, so the complex bandpass is two independent real ones
+            filterBank.process(inputTile, tile.harmonicRows, numTileSamples,
+                               channel * 2, startHarmonic, endHarmonic, chunkStages);
+            filterBank.process(inputImagTile, tile.harmonicImagRows, numTileSamples,
+                               channel * 2 + 1, startHarmonic, endHarmonic, chunkStages);
+        }
+        else if (mode == Mode::ComplexResonator)
+        {
+            resonatorBank.process(inputTile, tile.harmonicRows, tile.harmonicImagRows, numTileSamples,
+                                  channel, startHarmonic, endHarmonic, chunkStages);
+        }
+        else
+        {
+            filterBank.process(inputTile, tile.harmonicRows, numTileSamples,
+                               channel * 2, startHarmonic, endHarmonic, chunkStages);
+        }
+        lap.record(StageProfiler::Bandpass);
+
+        shiftGroupTile(channel, startHarmonic, endHarmonic, numTileSamples, inputPower, tile, getPartial(group, 0) + offset, lap);
+    }
+}
+
+void HarmonicEngine::shiftGroupTile(int channel, int startHarmonic, int endHarmonic, int numTileSamples, float inputPower,
+                                    const GroupTile& tile, HilbertProcessor::Complex* shiftedTiles, StageProfiler::Lap& lap) noexcept
+{
+    std::array<float, tileSize> analyticReal, analyticImag;
+    const auto& kernels = SIMDKernels::get();
+
+    for (int harmonic = startHarmonic; harmonic < endHarmonic; ++harmonic)
+    {
+        const auto row = harmonic - startHarmonic;
+
+        // Gating is charged to the band filters, as it's a pass over their output
+        const auto status = gate.update(channel, harmonic, tile.harmonicRows[row], numTileSamples, inputPower);
+        lap.record(StageProfiler::Bandpass);
+
+        const auto* gains = getMixGains(channel, harmonic);
+        const auto muted = std::all_of(gains, gains + chunkChannels, [](float gain) { return gain == 0.f; });
+
+        if (status != HarmonicGate::Status::Awake || muted)
+        {
+            // Start from silence when it wakes or is turned up, rather than from whatever the Hilbert held
+            if ((status == HarmonicGate::Status::FellAsleep || muted) && mode == Mode::PerHarmonicHilbert)
+                getHilbertState(channel, harmonic) = {};
+            continue;
+        }
+
+        if (mode == Mode::PerHarmonicHilbert)
+        {
+            // FrequencyShifter::process in its two halves, so each can be timed,
+            // with the Hilbert state coming from the arena and the mix gains applied
+            harmonicHilbertProcessor.processBlock(tile.harmonicRows[row], analyticReal.data(), analyticImag.data(),
+                                                  numTileSamples, getHilbertState(channel, harmonic));
+            lap.record(StageProfiler::Hilbert);
+
+            kernels.heterodyne(analyticReal.data(), analyticImag.data(), tile.phasorRows[row], tile.phasorImagRows[row],
+                               reinterpret_cast<float*>(shiftedTiles), chunkSize * 2, gains, chunkChannels, numTileSamples);
+        }
+        else
+        {
+            kernels.heterodyne(tile.harmonicRows[row], tile.harmonicImagRows[row],
+                               tile.phasorRows[row], tile.phasorImagRows[row],
+                               reinterpret_cast<float*>(shiftedTiles), chunkSize * 2, gains, chunkChannels, numTileSamples);
+        }
+        lap.record(StageProfiler::Heterodyne);
+    }
+}
+
+} // namespace xynth
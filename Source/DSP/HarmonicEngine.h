@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    HarmonicEngine.h
+    Created: 17 Oct 2026 1:20:31pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BandpassCoefficients.h"
+#include "BiquadBank.h"
+#include "BlockTracer.h"
+#include "FrequencyShifter.h"
+#include "HarmonicGate.h"
+#include "PhasorBank.h"
+#include "ResonatorBank.h"
+#include "SIMDKernels.h"
+#include "StateArena.h"
+#include "StageProfiler.h"
+#include "WorkerPool.h"
+
+namespace xynth
+{
+
+// Splits the input into bandpassed harmonics of the root, frequency shifts each
+// one and sums them back into the buffer. Work is done in short tiles so the
+// per-harmonic scratch stays in cache: the input tile is read once, every
+// harmonic is filtered and shifted, and the result is added straight into the
+// output. The shifted harmonics are summed as complex signals and anti-aliased
+// once per channel rather than once per harmonic.
+//
+// Each harmonic is added in with its own gain and, in stereo, its own pan, as
+// part of the same multiply-add that shifts it, so shaping the levels across
+// the series costs nothing on top. Harmonics turned all the way down are
+// skipped after the band filter, as if asleep.
+//
+// The harmonics are split into fixed groups that can run on a WorkerPool. Each
+// group renders both channels into its own partial sum, and the partials are
+// added up in group order afterwards, so the output does not depend on how
+// many threads took part. The scratch rows are per thread and only a group
+// deep, so they stay in cache however many harmonics there are, and memory
+// only grows with the filter states and partials.
+//
+// Harmonics whose band has gone quiet are put to sleep by a HarmonicGate and
+// skip everything after the band filter. The filters keep running, as they are
+// what notices the band coming back, so only the work after them follows
+// what's in the input. That is most of the cost in PerHarmonicHilbert mode,
+// with its Hilbert per harmonic. In SharedAnalytic and ComplexResonator modes a
+// harmonic is mostly filtering, and the cost still follows the harmonic count.
+//
+// Once the input has been silent for longer than the tail, the whole engine
+// idles: its filter states are cleared and process() only writes zeros until
+// sound comes back. The oscillators are moved on by the time that was skipped,
+// so the output is the same as if every block had been processed.
+//
+// The filter and gate states of every harmonic share one StateArena, sized to
+// the channels and harmonics given to prepare(), so they are contiguous. Only
+// the harmonics in use are ever written: a reset clears just those, and
+// harmonics coming back into use are cleared as the count rises. The
+// per-harmonic Hilbert filters are only states in it, all run through a
+// single set of coefficients.
+class HarmonicEngine : private WorkerPool::Job
+{
+public:
+    static constexpr int tileSize = 64;
+    // Samples handed to the workers per job, so there are few hand-offs per block
+    static constexpr int chunkSize = 4 * tileSize;
+    static constexpr int harmonicsPerGroup = 32;
+    // Input below this peak level (dBFS) counts as silence, and the tail is how
+    // long full-scale ringing takes to decay to it
+    static constexpr float silenceDb = -100.f;
+
+    enum class Mode
+    {
+        // Bandpass each harmonic, then run its own Hilbert filter
+        PerHarmonicHilbert,
+        // Run one Hilbert filter per channel up front, then bandpass the
+        // analytic signal. The filters are linear, so the output is the same.
+        SharedAnalytic,
+        // Replace bandpass + Hilbert with complex one-pole resonators. Sounds
+        // slightly different, but costs far less per harmonic.
+        ComplexResonator
+    };
+
+public:
+    HarmonicEngine() = default;
+
+    // Sizes everything for up to maxHarmonics. Only the harmonics process() is asked
+    // for are ever touched, so the memory for the rest costs nothing until it's used.
+    // Preparing again with the same spec and maxHarmonics does nothing, and keeps the state.
+    void prepare(const juce::dsp::ProcessSpec& spec, int maxHarmonics);
+    void reset() noexcept;
+
+    // Extra threads that help the calling thread render harmonic groups. 0 (the
+    // default) keeps everything on the calling thread. Don't call from the audio
+    // thread, or while process() is running.
+    void setNumWorkerThreads(int numThreads);
+    int getNumWorkerThreads() const noexcept { return workerPool.getNumWorkers(); }
+
+    // Switching modes resets the filter states of the harmonics in use, and leaves
+    // the oscillators running. Cheap enough for the audio thread.
+    void setMode(Mode newMode) noexcept;
+    Mode getMode() const noexcept { return mode; }
+
+    // The level a harmonic's band has to stay under to be skipped, see HarmonicGate.
+    // Minus infinity processes every harmonic all the time.
+    void setSleepThreshold(float decibels) noexcept { gate.setThreshold(decibels); }
+
+    // Both channels of a harmonic share one oscillator
+    void setShiftFrequency(int harmonic, float frequency) noexcept;
+
+    // How loud a harmonic comes out, and in stereo where. Pan runs from -1, which moves the
+    // right channel's harmonic over to the left, through 0, which leaves both channels where
+    // they are, to 1, which moves the left one right, at constant power. With other than two
+    // channels only the gain applies. Every harmonic starts at unity gain, centred.
+    // The workers read the gains during process(), so call this from the audio thread
+    // or between process() calls, never while process() is running.
+    void setHarmonicMix(int harmonic, float gain, float pan = 0.f) noexcept;
+
+    // How long the output rings on after the input stops with these settings: the
+    // band filter cascade for the root, which decays slowest, plus the Hilbert filters
+    double getTailSeconds(Mode mode, float rootFrequency, float resonance, int numStages) const noexcept;
+
+    // On by default. Off, every block is processed however long the silence.
+    void setIdleWhenSilent(bool shouldIdle) noexcept { idleWhenSilent = shouldIdle; }
+    // True while the input has been silent for longer than the tail
+    bool isIdle() const noexcept { return idle; }
+
+    // Returns the number of harmonics that fit below Nyquist for this root
+    int getNumHarmonicsBelowNyquist(float rootFrequency, int numHarmonics) const noexcept;
+
+    void process(juce::dsp::AudioBlock<float>& block, float rootFrequency, float resonance,
+                 int numHarmonics, int numStages) noexcept;
+
+    // Per-stage timings, when built with MODALSHIFT_PROFILE_STAGES
+    StageProfiler& getStageProfiler() noexcept { return profiler; }
+
+    // Records every process() call into the tracer, or nothing if it's null (the
+    // default). Don't change it while process() is running.
+    void setTracer(BlockTracer* newTracer) noexcept { tracer = newTracer; }
+
+private:
+    // Returns how many harmonics had to be recomputed
+    int updateCoefficients(float rootFrequency, float resonance, int numHarmonics) noexcept;
+    // Clears every filter state, but leaves the oscillators running
+    void resetFilters() noexcept;
+    // Clears the band filter, Hilbert and gate states of harmonics [startHarmonic, endHarmonic)
+    void clearHarmonics(int startHarmonic, int endHarmonic) noexcept;
+    // Tracks how long the input has been silent. Once that's longer than the tail,
+    // clears the block and returns true, as there's nothing left to process.
+    bool skipSilence(juce::dsp::AudioBlock<float>& block, float rootFrequency, float resonance, int numStages) noexcept;
+    void traceBlock(juce::int64 startTicks, int numSamples, int numHarmonics, int numStages, int numRetuned) noexcept;
+
+    // Band and oscillator rows for the harmonics of one group, one row per harmonic
+    // so neighbouring lanes never share a row
+    struct GroupTile
+    {
+        juce::AudioBuffer<float> buffer;
+        // Fetched once, as getArrayOfWritePointers() isn't safe to call from several threads.
+        // The imaginary harmonic rows are unused in PerHarmonicHilbert mode.
+        float* const* harmonicRows = nullptr;
+        float* const* harmonicImagRows = nullptr;
+        float* const* phasorRows = nullptr;
+        float* const* phasorImagRows = nullptr;
+    };
+
+    // One GroupTile for every thread the WorkerPool can run tasks on
+    void prepareGroupTiles();
+
+    // Renders one harmonic group of the current chunk into its partials
+    void runTask(int group, int threadIndex) noexcept override;
+    void processGroupTile(int group, GroupTile& tile, int offset, int numTileSamples, StageProfiler::Lap& lap) noexcept;
+    // Adds harmonics [startHarmonic, endHarmonic) of one channel's tile, from their band output
+    // in the tile's rows, to every channel's tile in shiftedTiles (one chunk apart) through its
+    // mix gains. Skips the ones the gate has put to sleep and the ones turned all the way down.
+    void shiftGroupTile(int channel, int startHarmonic, int endHarmonic, int numTileSamples, float inputPower,
+                        const GroupTile& tile, HilbertProcessor::Complex* shiftedTiles, StageProfiler::Lap& lap) noexcept;
+
+    HilbertProcessor::State& getHilbertState(int channel, int harmonic) noexcept
+    {
+        return hilbertStates.get()[channel * maxHarmonics + harmonic];
+    }
+
+    // How much of a harmonic on this input channel goes to each output channel
+    const float* getMixGains(int channel, int harmonic) const noexcept
+    {
+        return mixGains.data() + (harmonic * numChannels + channel) * numChannels;
+    }
+
+    HilbertProcessor::Complex* getPartial(int group, int channel) noexcept
+    {
+        return partials.get() + (group * numChannels + channel) * chunkSize;
+    }
+
+    juce::dsp::ProcessSpec spec { 44100.0, 0, 0 };
+    int maxHarmonics = 0, numChannels = 0;
+    Mode mode = Mode::PerHarmonicHilbert;
+
+    double hilbertTailSamples = 0.0;
+    juce::int64 silentSamples = 0, idleSamples = 0;
+    bool idleWhenSilent = true, idle = false;
+
+    // Harmonics below this have run since they were last cleared. Above it they
+    // may hold state from a higher count, which is cleared when they come back.
+    int activeHarmonics = 0;
+
+    // What the current chunk's tasks need to know
+    int chunkHarmonics = 0, chunkChannels = 0, chunkStages = 0, chunkSamples = 0;
+
+    BandpassCoefficients bandpassCoefficients;
+    BiquadBank filterBank;
+    ResonatorBank resonatorBank;
+    // Coefficients only, for the per-harmonic Hilbert states in the arena
+    HilbertProcessor harmonicHilbertProcessor;
+    HilbertProcessor inputHilbertProcessor, antialiasingProcessor;
+    PhasorBank phasorBank;
+    HarmonicGate gate;
+    StateArena stateArena;
+    // One per channel and harmonic, indexed channel * maxHarmonics + harmonic
+    StateArena::Region<HilbertProcessor::State> hilbertStates;
+    // A numChannels x numChannels matrix per harmonic, see getMixGains()
+    std::vector<float> mixGains;
+
+    WorkerPool workerPool;
+    StageProfiler profiler;
+    BlockTracer* tracer = nullptr;
+
+    // The chunk's input per channel, real in row channel * 2 and imaginary in row channel * 2 + 1
+    juce::AudioBuffer<float> inputChunk;
+    // Indexed by the thread index WorkerPool hands each task
+    std::vector<GroupTile> groupTiles;
+    // Shifted sums, one chunk per group and channel
+    juce::HeapBlock<HilbertProcessor::Complex> partials;
+    std::array<HilbertProcessor::Complex, chunkSize> shiftedChunk;
+
+};
+}
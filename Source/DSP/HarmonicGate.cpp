@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    HarmonicGate.cpp
+    Created: 20 Oct 2026 2:47:36pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "HarmonicGate.h"
+
+namespace xynth
+{
+
+namespace
+{
+
+// Compared with mean squares, so everything is in squared gains
+float toPower(float decibels) noexcept
+{
+    return std::pow(10.f, decibels * 0.1f);
+}
+
+} // namespace
+
+HarmonicGate::HarmonicGate()
+    : relativeGain(toPower(relativeThresholdDb)), hysteresisGain(toPower(hysteresisDb))
+{
+    setThreshold(defaultThresholdDb);
+}
+
+void HarmonicGate::prepare(int newMaxHarmonics, int newNumChannels, double sampleRate, StateArena& arena)
+{
+    maxHarmonics = newMaxHarmonics;
+    numChannels = newNumChannels;
+    holdLength = juce::jmax(1, juce::roundToInt(holdSeconds * sampleRate));
+    holdSamples = arena.reserve<int>(static_cast<size_t>(maxHarmonics * numChannels));
+}
+
+void HarmonicGate::reset(int startHarmonic, int endHarmonic) noexcept
+{
+    jassert(0 <= startHarmonic && startHarmonic <= endHarmonic && endHarmonic <= maxHarmonics);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        std::fill_n(holdSamples.get() + getIndex(channel, startHarmonic), endHarmonic - startHarmonic, 0);
+}
+
+void HarmonicGate::setThreshold(float decibels) noexcept
+{
+    enabled = decibels > -std::numeric_limits<float>::infinity();
+    floorPower = enabled ? toPower(decibels) : 0.f;
+}
+
+float HarmonicGate::getPower(const float* samples, int numSamples) noexcept
+{
+    auto sum = 0.f;
+    for (int i = 0; i < numSamples; ++i)
+        sum += samples[i] * samples[i];
+    return sum / static_cast<float>(numSamples);
+}
+
+HarmonicGate::Status HarmonicGate::update(int channel, int harmonic, const float* band, int numSamples, float inputPower) noexcept
+{
+    if (! enabled)
+        return Status::Awake;
+
+    const auto power = getPower(band, numSamples);
+    const auto sleepPower = juce::jmax(floorPower, inputPower * relativeGain);
+
+    auto& hold = holdSamples.get()[getIndex(channel, harmonic)];
+    if (power >= (hold > 0 ? sleepPower : sleepPower * hysteresisGain))
+    {
+        hold = holdLength;
+        return Status::Awake;
+    }
+
+    if (hold == 0)
+        return Status::Asleep;
+
+    hold = juce::jmax(0, hold - numSamples);
+    return hold > 0 ? Status::Awake : Status::FellAsleep;
+}
+
+} // namespace xynth
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    HarmonicGate.h
+    Created: 20 Oct 2026 2:47:36pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StateArena.h"
+
+namespace xynth
+{
+
+// Puts harmonics to sleep while their band is silent, so HarmonicEngine can skip
+// the Hilbert and heterodyne work for them. Each harmonic of each channel tracks
+// the mean-square level of its band output per tile. It falls asleep once that
+// has stayed under the threshold for holdSeconds, and wakes as soon as one tile
+// comes in hysteresisDb above it, before that tile is shifted, so onsets are
+// never cut. The band filters themselves keep running: they are what notices
+// the energy coming back.
+//
+// The threshold is an absolute floor, or relativeThresholdDb under the
+// channel's input level if that's higher: a band that far below everything
+// else adds nothing audible, and with a loud input no band is ever truly silent.
+//
+// Harmonics only ever touch their own state, so groups can update it from any thread.
+class HarmonicGate
+{
+public:
+    enum class Status
+    {
+        Asleep,
+        Awake,
+        // Asleep from this tile on, so its downstream state can be flushed
+        FellAsleep
+    };
+
+    static constexpr float defaultThresholdDb = -100.f;
+    static constexpr float relativeThresholdDb = -90.f;
+    static constexpr float hysteresisDb = 6.f;
+    static constexpr double holdSeconds = 0.05;
+
+public:
+    HarmonicGate();
+
+    // Reserves the per-harmonic state in arena, which the caller then allocates
+    void prepare(int maxHarmonics, int numChannels, double sampleRate, StateArena& arena);
+    // Puts harmonics [startHarmonic, endHarmonic) to sleep on every channel, as
+    // after a reset there's nothing ringing
+    void reset(int startHarmonic, int endHarmonic) noexcept;
+
+    // The RMS level in dBFS a band has to fall below to sleep, however quiet the
+    // input. Minus infinity turns the gate off and keeps every harmonic awake.
+    void setThreshold(float decibels) noexcept;
+
+    // The mean square of an input tile, what update() takes as inputPower
+    static float getPower(const float* samples, int numSamples) noexcept;
+
+    // Measures one tile of a harmonic's band output and says whether to process it.
+    // inputPower is the mean square of the same tile of the channel's input.
+    Status update(int channel, int harmonic, const float* band, int numSamples, float inputPower) noexcept;
+
+    bool isAwake(int channel, int harmonic) const noexcept { return holdSamples.get()[getIndex(channel, harmonic)] > 0; }
+
+private:
+    size_t getIndex(int channel, int harmonic) const noexcept
+    {
+        return static_cast<size_t>(channel * maxHarmonics + harmonic);
+    }
+
+    // Samples left before each harmonic may sleep, 0 when it's asleep
+    StateArena::Region<int> holdSamples;
+    int maxHarmonics = 0, numChannels = 0, holdLength = 0;
+    bool enabled = true;
+    float floorPower = 0.f, relativeGain = 0.f, hysteresisGain = 0.f;
+
+};
+}
@@ -46,6 +46,19 @@ void HilbertProcessor::reset() noexcept
 	}
 }
 
+double HilbertProcessor::getTailSamples(float decibels) const noexcept
+{
+	double radius = 0.0;
+	for (int i = 0; i < order; ++i)
+		radius = std::max(radius, std::hypot(double(polesReal[i]), double(polesImag[i])));
+
+	if (radius <= 0.0)
+		return 0.0;
+
+	// |pole|^n falls by 20 log10(|pole|) dB per sample
+	return decibels / (-20.0 * std::log10(radius));
+}
+
 // HilbertProcessor::Complex HilbertProcessor::processSample(float sample, int channel) noexcept
 // {
 // 	jassert(channel < states.size());
@@ -78,7 +91,7 @@ HilbertProcessor::Complex HilbertProcessor::processSample(float sample, int chan
     jassert(channel < states.size());
     
     State& currentState = states[channel];
-    State newState;
+    State newState {};
     
     float resultReal = sample * direct;
     float resultImag = 0;
@@ -107,7 +120,7 @@ HilbertProcessor::Complex HilbertProcessor::processSample(Complex sample, int ch
 	// Really we're just doing: state[i] = state[i]*poles[i] + sample*coeffs[i]
 	// but std::complex is slow without -ffast-math, so we've unwrapped it
 
-	State state = states[channel], newState;
+	State state = states[channel], newState {};
 	for (int i = 0; i < order; ++i)
 		newState.real[i] = state.real[i] * polesReal[i] - state.imag[i] * polesImag[i] 
 						 + sample.real() * coeffsReal[i] - sample.imag() * coeffsImag[i];
@@ -129,5 +142,38 @@ HilbertProcessor::Complex HilbertProcessor::processSample(Complex sample, int ch
 	return { resultReal, resultImag };
 }
 
-} // namespace xynth
+void HilbertProcessor::processBlock(const float* inputSamples, Complex* outputSamples, int numSamples, int channel) noexcept
+{
+	jassert(channel < static_cast<int>(states.size()));
+	processBlock(inputSamples, outputSamples, numSamples, states[channel]);
+}
 
+void HilbertProcessor::processBlock(const Complex* inputSamples, Complex* outputSamples, int numSamples, int channel) noexcept
+{
+	jassert(channel < static_cast<int>(states.size()));
+	auto& state = states[channel];
+
+	// std::complex is laid out as two floats, so complex blocks go through as interleaved
+	auto* output = reinterpret_cast<float*>(outputSamples);
+	SIMDKernels::get().hilbertComplex(reinterpret_cast<const float*>(inputSamples), output, output + 1, 2,
+									  numSamples, getFilter(), state.real.data(), state.imag.data());
+}
+
+void HilbertProcessor::processBlock(const float* inputSamples, Complex* outputSamples, int numSamples, State& state) const noexcept
+{
+	auto* output = reinterpret_cast<float*>(outputSamples);
+	SIMDKernels::get().hilbert(inputSamples, output, output + 1, 2, numSamples, getFilter(), state.real.data(), state.imag.data());
+}
+
+void HilbertProcessor::processBlock(const float* inputSamples, float* outputReal, float* outputImag, int numSamples, State& state) const noexcept
+{
+	SIMDKernels::get().hilbert(inputSamples, outputReal, outputImag, 1, numSamples, getFilter(), state.real.data(), state.imag.data());
+}
+
+void HilbertProcessor::processBlock(const float* inputSamples, float* outputReal, float* outputImag, int numSamples, int channel) noexcept
+{
+	jassert(channel < static_cast<int>(states.size()));
+	processBlock(inputSamples, outputReal, outputImag, numSamples, states[channel]);
+}
+
+} // namespace xynth
@@ -12,6 +12,7 @@
 
 #include <JuceHeader.h>
 #include "../Vendor/hilbert-iir/hilbert.h"
+#include "SIMDKernels.h"
 
 namespace xynth
 {
@@ -23,6 +24,16 @@ public:
     using Complex = std::complex<float>;
     using HilbertIIRCoeffs = signalsmith::hilbert::HilbertIIRCoeffs<float>;
     static constexpr int order = HilbertIIRCoeffs::order;
+    // Poles are padded with zeros up to whole registers of the widest SIMDKernels
+    static constexpr int paddedOrder = SIMDKernels::hilbertPaddedOrder;
+    static_assert(order == SIMDKernels::hilbertOrder, "the kernels unroll for this order");
+
+    struct alignas(64) Array : std::array<float, paddedOrder> {};
+    // The pole states of one filter. Zero is the reset state.
+    struct State 
+    {
+        Array real, imag;
+    };
     
 
 public:
@@ -31,18 +42,30 @@ public:
     void prepare(const juce::dsp::ProcessSpec& spec, float passbandGain = 2.f) noexcept;
     void reset() noexcept;
 
+    // How many samples the slowest pole takes to decay by the given number of decibels
+    double getTailSamples(float decibels) const noexcept;
+
     Complex processSample(float sample, int channel) noexcept;
     Complex processSample(Complex sample, int channel) noexcept;
-//    void processBlock(const float* inputSamples, Complex* outputSamples, int numSamples, int channel) noexcept;
+
+    // Block versions keep the pole states in SIMD registers for the whole block, using
+    // SIMDKernels. Input and output may point to the same memory.
+    void processBlock(const float* inputSamples, Complex* outputSamples, int numSamples, int channel) noexcept;
+    void processBlock(const Complex* inputSamples, Complex* outputSamples, int numSamples, int channel) noexcept;
+    // As above, on a state kept by the caller, so many filters can share one set of
+    // coefficients. A processor prepared with no channels holds nothing else.
+    void processBlock(const float* inputSamples, Complex* outputSamples, int numSamples, State& state) const noexcept;
+    // As above, with the real and imaginary parts written to separate arrays
+    void processBlock(const float* inputSamples, float* outputReal, float* outputImag, int numSamples, State& state) const noexcept;
+    void processBlock(const float* inputSamples, float* outputReal, float* outputImag, int numSamples, int channel) noexcept;
 
 protected:
-    using Array = std::array<float, order>;
-    struct State 
+    SIMDKernels::HilbertFilter getFilter() const noexcept
     {
-        Array real, imag;
-    };
+        return { coeffsReal.data(), coeffsImag.data(), polesReal.data(), polesImag.data(), direct };
+    }
 
-    Array coeffsReal, coeffsImag, polesReal, polesImag;
+    Array coeffsReal {}, coeffsImag {}, polesReal {}, polesImag {};
     std::vector<State> states;
     float direct;
 
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    PhasorBank.cpp
+    Created: 17 Oct 2026 4:05:52pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "PhasorBank.h"
+
+namespace xynth
+{
+
+void PhasorBank::prepare(int newMaxHarmonics, double sampleRate)
+{
+    constexpr int groupWidth = SIMDKernels::maxGroupWidth;
+    maxHarmonics = newMaxHarmonics;
+    stride = (maxHarmonics + groupWidth - 1) / groupWidth * groupWidth;
+    radiansCoefficient = juce::MathConstants<float>::twoPi / (float)sampleRate;
+
+    storage.calloc(static_cast<size_t>(numArrays * stride + SIMDKernels::maxLaneWidth));
+    arrays = juce::snapPointerToAlignment(storage.get(), static_cast<size_t>(SIMDKernels::maxLaneWidth) * sizeof(float));
+
+    // Start every harmonic unshifted
+    frequencies.assign(static_cast<size_t>(stride), 0.f);
+    juce::FloatVectorOperations::fill(array(stepReal), 1.f, stride);
+    reset();
+}
+
+void PhasorBank::reset() noexcept
+{
+    juce::FloatVectorOperations::fill(array(phaseReal), 1.f, stride);
+    juce::FloatVectorOperations::clear(array(phaseImag), stride);
+}
+
+void PhasorBank::setFrequency(int harmonic, float frequency) noexcept
+{
+    jassert(harmonic < maxHarmonics);
+
+    if (frequencies[harmonic] == frequency)
+        return;
+
+    frequencies[harmonic] = frequency;
+    const auto phaseDelta = frequency * radiansCoefficient;
+    array(stepReal)[harmonic] = std::cos(phaseDelta);
+    array(stepImag)[harmonic] = std::sin(phaseDelta);
+}
+
+void PhasorBank::advance(juce::int64 numSamples, int numHarmonics) noexcept
+{
+    jassert(numHarmonics <= maxHarmonics);
+
+    for (int harmonic = 0; harmonic < numHarmonics; ++harmonic)
+    {
+        if (frequencies[harmonic] == 0.f)
+            continue;
+
+        // The same step setFrequency() rotates by, wrapped in double as the total can be huge
+        const auto phaseDelta = static_cast<double>(frequencies[harmonic] * radiansCoefficient);
+        const auto angle = std::fmod(phaseDelta * static_cast<double>(numSamples), juce::MathConstants<double>::twoPi);
+        const auto rotationReal = static_cast<float>(std::cos(angle));
+        const auto rotationImag = static_cast<float>(std::sin(angle));
+
+        auto& real = array(phaseReal)[harmonic];
+        auto& imag = array(phaseImag)[harmonic];
+        const auto newReal = real * rotationReal - imag * rotationImag;
+        imag = real * rotationImag + imag * rotationReal;
+        real = newReal;
+    }
+}
+
+void PhasorBank::process(float* const* real, float* const* imag, int numSamples, int startHarmonic, int endHarmonic) noexcept
+{
+    jassert(endHarmonic <= maxHarmonics);
+    jassert(startHarmonic % laneWidth == 0);
+
+    SIMDKernels::get().phasorBank(real, imag, numSamples, arrays, stride, startHarmonic, endHarmonic);
+}
+
+} // namespace xynth
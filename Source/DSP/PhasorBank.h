@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    PhasorBank.h
+    Created: 17 Oct 2026 4:05:52pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SIMDKernels.h"
+
+namespace xynth
+{
+
+// Heterodyne oscillators for every harmonic, generated by rotating a complex
+// phasor one step per sample instead of calling sin and cos. Harmonics are laid
+// out structure-of-arrays and rotated together in SIMD lanes, by whichever
+// SIMDKernels the CPU runs best. The magnitude is
+// pulled back to one after every call so rounding can't make it drift.
+class PhasorBank
+{
+public:
+    static constexpr int laneWidth = SIMDKernels::maxLaneWidth;
+
+public:
+    PhasorBank() = default;
+
+    void prepare(int maxHarmonics, double sampleRate);
+    void reset() noexcept;
+
+    void setFrequency(int harmonic, float frequency) noexcept;
+
+    // Moves the phasors of harmonics [0, numHarmonics) on by numSamples without writing
+    // them out, as if process() had run. The rest weren't running, so they stay put.
+    void advance(juce::int64 numSamples, int numHarmonics) noexcept;
+
+    // Writes numSamples of the phasor of each harmonic in [startHarmonic, endHarmonic) to
+    // real[h - startHarmonic] and imag[h - startHarmonic] and advances it. Same range rules as BiquadBank::process.
+    void process(float* const* real, float* const* imag, int numSamples, int startHarmonic, int endHarmonic) noexcept;
+
+private:
+    // In the order SIMDKernels::PhasorKernel expects
+    enum ArrayIndex { phaseReal, phaseImag, stepReal, stepImag, numArrays };
+    float* array(ArrayIndex index) const noexcept { return arrays + index * stride; }
+
+    juce::HeapBlock<float> storage;
+    float* arrays = nullptr;
+    std::vector<float> frequencies;
+    int stride = 0, maxHarmonics = 0;
+    float radiansCoefficient = 0.f;
+
+};
+}
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.cpp
+    Created: 20 Oct 2026 10:14:03am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "QualityGovernor.h"
+
+namespace xynth
+{
+
+namespace
+{
+
+// Time constant of the load smoothing, and how long a new level gets to show
+// its effect before the governor steps again
+constexpr double smoothingSeconds = 0.05;
+constexpr double settleSeconds = 0.1;
+
+} // namespace
+
+void QualityGovernor::prepare(double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+    fadeSamples = juce::jmax(1, juce::roundToInt(fadeSeconds * sampleRate));
+    reset();
+}
+
+void QualityGovernor::reset() noexcept
+{
+    level = targetLevel = 0;
+    atFloor = false;
+    fade = Fade::None;
+    fadeRemaining = 0;
+    smoothedLoad = 0.0;
+    secondsSinceChange = secondsBelow = 0.0;
+    recoverySeconds = minRecoverySeconds;
+    lastChangeWasUp = false;
+
+    publishedLevel.store(0, std::memory_order_relaxed);
+    publishedHarmonics.store(0, std::memory_order_relaxed);
+    publishedStages.store(0, std::memory_order_relaxed);
+    publishedShared.store(false, std::memory_order_relaxed);
+}
+
+QualityGovernor::Settings QualityGovernor::reduce(Settings settings, int level, int* stepsTaken) noexcept
+{
+    int step = 0;
+    for (; step < level; ++step)
+    {
+        if (settings.numStages > 1)
+            --settings.numStages;
+        else if (settings.numHarmonics > minHarmonics)
+            settings.numHarmonics = juce::jmax(minHarmonics, settings.numHarmonics / 2);
+        else if (settings.mode == HarmonicEngine::Mode::PerHarmonicHilbert)
+            settings.mode = HarmonicEngine::Mode::SharedAnalytic;
+        else
+            break;
+    }
+
+    if (stepsTaken != nullptr)
+        *stepsTaken = step;
+
+    return settings;
+}
+
+QualityGovernor::Settings QualityGovernor::begin(const Settings& requested, bool isEnabled) noexcept
+{
+    enabled = isEnabled;
+    if (! enabled && level != 0 && fade == Fade::None)
+        startFadeOut(0);
+
+    // The old level has faded out completely, so switch while it's silent
+    if (fade == Fade::Out && fadeRemaining == 0)
+    {
+        lastChangeWasUp = targetLevel < level;
+        level = targetLevel;
+        fade = Fade::In;
+        fadeRemaining = fadeSamples;
+        secondsSinceChange = secondsBelow = 0.0;
+    }
+
+    // The requested settings may have less left to take off than they had
+    int stepsTaken = 0;
+    const auto settings = reduce(requested, level, &stepsTaken);
+    level = juce::jmin(level, stepsTaken);
+
+    reduce(requested, level + 1, &stepsTaken);
+    atFloor = stepsTaken <= level;
+
+    publish(requested, settings);
+    return settings;
+}
+
+void QualityGovernor::end(juce::dsp::AudioBlock<float>& block, double seconds) noexcept
+{
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+    if (numSamples == 0)
+        return;
+
+    const auto duration = numSamples / sampleRate;
+    const auto load = seconds / duration;
+    smoothedLoad += (1.0 - std::exp(-duration / smoothingSeconds)) * (load - smoothedLoad);
+    secondsSinceChange += duration;
+    secondsBelow = smoothedLoad < stepUpLoad ? secondsBelow + duration : 0.0;
+
+    if (enabled && fade == Fade::None && secondsSinceChange >= settleSeconds)
+    {
+        if ((load > 1.0 || smoothedLoad > stepDownLoad) && ! atFloor)
+        {
+            // Stepping up didn't fit after all, so wait longer before trying again
+            if (lastChangeWasUp && secondsSinceChange < recoverySeconds)
+                recoverySeconds = juce::jmin(recoverySeconds * 2.0, maxRecoverySeconds);
+
+            startFadeOut(level + 1);
+        }
+        else if (level > 0 && secondsBelow >= recoverySeconds)
+        {
+            startFadeOut(level - 1);
+        }
+    }
+
+    applyFade(block);
+}
+
+void QualityGovernor::startFadeOut(int newLevel) noexcept
+{
+    targetLevel = newLevel;
+    fade = Fade::Out;
+    fadeRemaining = fadeSamples;
+}
+
+void QualityGovernor::applyFade(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    if (fade == Fade::None)
+        return;
+
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+    const auto gainPerSample = 1.f / static_cast<float>(fadeSamples);
+
+    // A fade out ends with the block it starts in when it fits, so there's no
+    // silence before the switch. When it doesn't, it carries on from the start
+    // of the next blocks, and whatever follows its end is silent until the
+    // switch. Fade ins start with the block. Either may run over several blocks.
+    const auto starting = fade == Fade::Out && fadeRemaining == fadeSamples;
+    const auto start = starting ? juce::jmax(0, numSamples - fadeRemaining) : 0;
+    const auto end = juce::jmin(numSamples, start + fadeRemaining);
+    const auto done = fadeSamples - fadeRemaining;
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* samples = block.getChannelPointer(channel);
+        for (int i = start; i < end; ++i)
+        {
+            const auto position = static_cast<float>(done + i - start + 1) * gainPerSample;
+            samples[i] *= fade == Fade::Out ? 1.f - position : position;
+        }
+
+        if (fade == Fade::Out)
+            std::fill(samples + end, samples + numSamples, 0.f);
+    }
+
+    fadeRemaining -= end - start;
+    if (fade == Fade::In && fadeRemaining == 0)
+        fade = Fade::None;
+}
+
+void QualityGovernor::publish(const Settings& requested, const Settings& applied) noexcept
+{
+    publishedLevel.store(level, std::memory_order_relaxed);
+    publishedHarmonics.store(applied.numHarmonics < requested.numHarmonics ? applied.numHarmonics : 0, std::memory_order_relaxed);
+    publishedStages.store(applied.numStages < requested.numStages ? applied.numStages : 0, std::memory_order_relaxed);
+    publishedShared.store(applied.mode != requested.mode, std::memory_order_relaxed);
+}
+
+juce::String QualityGovernor::getDescription() const
+{
+    if (getLevel() == 0)
+        return "full quality";
+
+    juce::StringArray reductions;
+    if (const auto stages = publishedStages.load(std::memory_order_relaxed); stages > 0)
+        reductions.add("order " + juce::String(stages));
+    if (const auto harmonics = publishedHarmonics.load(std::memory_order_relaxed); harmonics > 0)
+        reductions.add(juce::String(harmonics) + " harmonics");
+    if (publishedShared.load(std::memory_order_relaxed))
+        reductions.add("shared Hilbert");
+
+    return "level " + juce::String(getLevel()) + ": " + reductions.joinIntoString(", ");
+}
+
+} // namespace xynth
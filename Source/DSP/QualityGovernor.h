@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.h
+    Created: 20 Oct 2026 10:14:03am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "HarmonicEngine.h"
+
+namespace xynth
+{
+
+// Keeps HarmonicEngine inside the real-time budget by trading quality for CPU.
+// Each block's processing time is compared with the block's duration; when the
+// smoothed load gets too high the governor steps down a level, and once it has
+// stayed low for a while it steps back up. Each level takes one more step off
+// the requested settings, cheapest loss first:
+//
+//   1. one filter stage fewer, down to a single stage
+//   2. half the harmonics, keeping the low ones, down to minHarmonics. The highest
+//      go rather than the quietest, as the engine renders a contiguous run of
+//      harmonics from the root, and a muted one in the middle costs as much as before.
+//   3. one Hilbert transform per channel (SharedAnalytic) instead of one per harmonic
+//
+// Level changes are a short gap rather than a crossfade, which would run both
+// settings at once just when there's no CPU for it: the old settings fade out
+// to silence, and the new ones fade in from the next block. The dip lasts up
+// to a block plus fadeSeconds.
+//
+// begin() and end() are for the audio thread, the getters for any thread.
+class QualityGovernor
+{
+public:
+    struct Settings
+    {
+        int numHarmonics = 0, numStages = 1;
+        HarmonicEngine::Mode mode = HarmonicEngine::Mode::PerHarmonicHilbert;
+    };
+
+    // Loads are processing time over the block's duration
+    static constexpr double stepDownLoad = 0.6, stepUpLoad = 0.3;
+    static constexpr int minHarmonics = 4;
+    static constexpr double fadeSeconds = 0.005;
+    // Time the load has to stay low before stepping up. Doubles each time a step
+    // up has to be undone straight away, so a borderline load doesn't oscillate.
+    static constexpr double minRecoverySeconds = 1.0, maxRecoverySeconds = 16.0;
+
+    QualityGovernor() = default;
+
+    void prepare(double sampleRate) noexcept;
+    // Back to full quality, without a fade
+    void reset() noexcept;
+
+    // The settings to process this block with. Disabled, the governor returns
+    // to full quality and stays there.
+    Settings begin(const Settings& requested, bool enabled) noexcept;
+    // Takes the time the block took and fades it if the level is changing
+    void end(juce::dsp::AudioBlock<float>& block, double seconds) noexcept;
+
+    // 0 is full quality
+    int getLevel() const noexcept { return publishedLevel.load(std::memory_order_relaxed); }
+    // What the current level has taken off, e.g. "order 1, 32 harmonics"
+    juce::String getDescription() const;
+
+    // The requested settings with level steps taken off. stepsTaken is less
+    // than level when there was nothing left to take.
+    static Settings reduce(Settings settings, int level, int* stepsTaken = nullptr) noexcept;
+
+private:
+    enum class Fade { None, In, Out };
+
+    void startFadeOut(int newLevel) noexcept;
+    void applyFade(juce::dsp::AudioBlock<float>& block) noexcept;
+    void publish(const Settings& requested, const Settings& applied) noexcept;
+
+    double sampleRate = 44100.0;
+    int fadeSamples = 1;
+
+    bool enabled = false, atFloor = false;
+    int level = 0, targetLevel = 0;
+    Fade fade = Fade::None;
+    int fadeRemaining = 0;
+
+    double smoothedLoad = 0.0;
+    double secondsSinceChange = 0.0, secondsBelow = 0.0;
+    double recoverySeconds = minRecoverySeconds;
+    bool lastChangeWasUp = false;
+
+    // For the UI: 0 where that setting hasn't been reduced
+    std::atomic<int> publishedLevel { 0 }, publishedHarmonics { 0 }, publishedStages { 0 };
+    std::atomic<bool> publishedShared { false };
+
+    JUCE_DECLARE_NON_COPYABLE(QualityGovernor)
+};
+}
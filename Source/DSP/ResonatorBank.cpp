@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    ResonatorBank.cpp
+    Created: 17 Oct 2026 5:32:18pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "ResonatorBank.h"
+
+namespace xynth
+{
+
+void ResonatorBank::prepare(int newMaxHarmonics, int newNumChannels, double newSampleRate, StateArena& arena)
+{
+    constexpr int groupWidth = 4 * laneWidth;
+    maxHarmonics = newMaxHarmonics;
+    numChannels = newNumChannels;
+    sampleRate = static_cast<float>(newSampleRate);
+    stride = (maxHarmonics + groupWidth - 1) / groupWidth * groupWidth;
+
+    storage.calloc(static_cast<size_t>(numCoefficients * stride + laneWidth));
+    arrays = SIMD::getNextSIMDAlignedPtr(storage.get());
+    states = arena.reserve<float>(static_cast<size_t>(numChannels * maxStages * 2 * stride));
+
+    frequencies.assign(static_cast<size_t>(maxHarmonics), std::numeric_limits<float>::quiet_NaN());
+    qs.assign(static_cast<size_t>(maxHarmonics), std::numeric_limits<float>::quiet_NaN());
+}
+
+void ResonatorBank::reset(int startHarmonic, int endHarmonic) noexcept
+{
+    jassert(0 <= startHarmonic && startHarmonic <= endHarmonic && endHarmonic <= maxHarmonics);
+
+    // Each channel, stage and state variable is a row by harmonic, so only
+    // the part of every row for this range is written
+    for (int channel = 0; channel < numChannels; ++channel)
+        for (int stage = 0; stage < maxStages; ++stage)
+            for (int index = 0; index < 2; ++index)
+                juce::FloatVectorOperations::clear(stateArray(channel, stage, index) + startHarmonic, endHarmonic - startHarmonic);
+}
+
+bool ResonatorBank::setResonance(int harmonic, float frequency, float q) noexcept
+{
+    jassert(harmonic < maxHarmonics);
+
+    if (frequencies[harmonic] == frequency && qs[harmonic] == q)
+        return false;
+
+    frequencies[harmonic] = frequency;
+    qs[harmonic] = q;
+
+    // A one-pole's -3 dB bandwidth is roughly (1 - r) * sampleRate / pi
+    const auto radius = std::exp(-juce::MathConstants<float>::pi * frequency / (q * sampleRate));
+    const auto angle = juce::MathConstants<float>::twoPi * frequency / sampleRate;
+
+    coefficientArray(poleReal)[harmonic] = radius * std::cos(angle);
+    coefficientArray(poleImag)[harmonic] = radius * std::sin(angle);
+    // g / (1 - r) is unity at the centre
+    coefficientArray(gain)[harmonic] = 1.f - radius;
+    return true;
+}
+
+void ResonatorBank::process(const float* input, float* const* real, float* const* imag, int numSamples,
+                            int channel, int startHarmonic, int endHarmonic, int numStages) noexcept
+{
+    jassert(channel < numChannels);
+    jassert(endHarmonic <= maxHarmonics);
+    jassert(numStages >= 1 && numStages <= maxStages);
+    jassert(startHarmonic % laneWidth == 0);
+
+    const auto& kernel = kernels[static_cast<size_t>(juce::jlimit(1, maxStages, numStages) - 1)];
+
+    int harmonic = startHarmonic;
+    while (harmonic < endHarmonic)
+    {
+        const auto remaining = endHarmonic - harmonic;
+        auto* const* groupReal = real + (harmonic - startHarmonic);
+        auto* const* groupImag = imag + (harmonic - startHarmonic);
+
+        if (remaining >= 4 * laneWidth)
+        {
+            (this->*kernel.wide)(input, groupReal, groupImag, numSamples, channel, harmonic, endHarmonic);
+            harmonic += 4 * laneWidth;
+        }
+        else if (remaining > laneWidth)
+        {
+            (this->*kernel.pair)(input, groupReal, groupImag, numSamples, channel, harmonic, endHarmonic);
+            harmonic += 2 * laneWidth;
+        }
+        else
+        {
+            (this->*kernel.single)(input, groupReal, groupImag, numSamples, channel, harmonic, endHarmonic);
+            harmonic += laneWidth;
+        }
+    }
+}
+
+template <int numRegisters, int numStages>
+void ResonatorBank::processGroup(const float* input, float* const* real, float* const* imag, int numSamples,
+                                 int channel, int firstHarmonic, int endHarmonic) noexcept
+{
+    constexpr int groupWidth = numRegisters * laneWidth;
+    const auto numLanes = juce::jmin(groupWidth, endHarmonic - firstHarmonic);
+
+    SIMD pr[numRegisters], pi[numRegisters], g[numRegisters];
+    SIMD yr[numStages][numRegisters], yi[numStages][numRegisters];
+
+    for (int r = 0; r < numRegisters; ++r)
+    {
+        const auto offset = firstHarmonic + r * laneWidth;
+        pr[r] = SIMD::fromRawArray(coefficientArray(poleReal) + offset);
+        pi[r] = SIMD::fromRawArray(coefficientArray(poleImag) + offset);
+        g[r] = SIMD::fromRawArray(coefficientArray(gain) + offset);
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            yr[stage][r] = SIMD::fromRawArray(stateArray(channel, stage, 0) + offset);
+            yi[stage][r] = SIMD::fromRawArray(stateArray(channel, stage, 1) + offset);
+        }
+    }
+
+    alignas(sizeof(SIMD)) float lanesReal[groupWidth];
+    alignas(sizeof(SIMD)) float lanesImag[groupWidth];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // A real input splits evenly between positive and negative frequencies,
+        // and only the positive half passes, so start at twice the level
+        const auto in = SIMD::expand(2.f * input[i]);
+
+        for (int r = 0; r < numRegisters; ++r)
+        {
+            // y = p * y + g * x, with x real for the first stage
+            auto xr = in, xi = SIMD::expand(0.f);
+            for (int stage = 0; stage < numStages; ++stage)
+            {
+                const auto newReal = pr[r] * yr[stage][r] - pi[r] * yi[stage][r] + g[r] * xr;
+                yi[stage][r] = pr[r] * yi[stage][r] + pi[r] * yr[stage][r] + g[r] * xi;
+                yr[stage][r] = newReal;
+                xr = yr[stage][r];
+                xi = yi[stage][r];
+            }
+            xr.copyToRawArray(lanesReal + r * laneWidth);
+            xi.copyToRawArray(lanesImag + r * laneWidth);
+        }
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            real[lane][i] = lanesReal[lane];
+            imag[lane][i] = lanesImag[lane];
+        }
+    }
+
+    // Only write back the lanes in use, so inactive harmonics keep their state
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        for (int index = 0; index < 2; ++index)
+        {
+            auto& y = index == 0 ? yr[stage] : yi[stage];
+            for (int r = 0; r < numRegisters; ++r)
+                y[r].copyToRawArray(lanesReal + r * laneWidth);
+
+            auto* state = stateArray(channel, stage, index) + firstHarmonic;
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                state[lane] = lanesReal[lane];
+                juce::dsp::util::snapToZero(state[lane]);
+            }
+        }
+    }
+}
+
+template <int numStages>
+constexpr ResonatorBank::Kernels ResonatorBank::makeKernels() noexcept
+{
+    return { &ResonatorBank::processGroup<4, numStages>,
+             &ResonatorBank::processGroup<2, numStages>,
+             &ResonatorBank::processGroup<1, numStages> };
+}
+
+const std::array<ResonatorBank::Kernels, ResonatorBank::maxStages> ResonatorBank::kernels {
+    makeKernels<1>(), makeKernels<2>(), makeKernels<3>(), makeKernels<4>()
+};
+
+} // namespace xynth
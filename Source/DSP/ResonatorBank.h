@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    ResonatorBank.h
+    Created: 17 Oct 2026 5:32:18pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StateArena.h"
+
+namespace xynth
+{
+
+// A cheaper alternative to bandpass + Hilbert: each harmonic is a cascade of
+// complex one-pole resonators centred on the harmonic, the same parallel
+// complex-pole structure HilbertProcessor uses. A complex pole only rings at
+// positive frequencies, so the output is already an analytic, band-limited
+// signal with unity gain at the centre. Harmonics are stepped together in SIMD
+// lanes, structure-of-arrays, with the states in a StateArena.
+class ResonatorBank
+{
+public:
+    using SIMD = juce::dsp::SIMDRegister<float>;
+    static constexpr int laneWidth = static_cast<int>(SIMD::SIMDNumElements);
+    static constexpr int maxStages = 4;
+
+public:
+    ResonatorBank() = default;
+
+    // Reserves the filter states in arena, which the caller then allocates
+    void prepare(int maxHarmonics, int numChannels, double sampleRate, StateArena& arena);
+    // Clears the states of harmonics [startHarmonic, endHarmonic) on every channel
+    void reset(int startHarmonic, int endHarmonic) noexcept;
+
+    // Bandwidth follows the bandpass definition, frequency / q. Only recomputes on change,
+    // and returns true if it did.
+    bool setResonance(int harmonic, float frequency, float q) noexcept;
+
+    // Runs harmonics [startHarmonic, endHarmonic) over a real input, writing the analytic output
+    // of harmonic h to real[h - startHarmonic] and imag[h - startHarmonic]. Same range rules as BiquadBank::process.
+    void process(const float* input, float* const* real, float* const* imag, int numSamples,
+                 int channel, int startHarmonic, int endHarmonic, int numStages) noexcept;
+
+private:
+    // Templated on the cascade length like kernels::biquadGroup in SIMDKernelTemplates.h
+    template <int numRegisters, int numStages>
+    void processGroup(const float* input, float* const* real, float* const* imag, int numSamples,
+                      int channel, int firstHarmonic, int endHarmonic) noexcept;
+
+    using GroupKernel = void (ResonatorBank::*)(const float*, float* const*, float* const*, int, int, int, int) noexcept;
+    struct Kernels { GroupKernel wide, pair, single; };
+
+    template <int numStages>
+    static constexpr Kernels makeKernels() noexcept;
+    static const std::array<Kernels, maxStages> kernels;
+
+    enum CoefficientIndex { poleReal, poleImag, gain, numCoefficients };
+    float* coefficientArray(CoefficientIndex index) const noexcept { return arrays + index * stride; }
+    // Laid out for maxStages whatever the order, so the order can change between blocks
+    float* stateArray(int channel, int stage, int index) const noexcept
+    {
+        return states.get() + ((channel * maxStages + stage) * 2 + index) * stride;
+    }
+
+    juce::HeapBlock<float> storage;
+    float* arrays = nullptr;
+    StateArena::Region<float> states;
+    std::vector<float> frequencies, qs;
+    int stride = 0, maxHarmonics = 0, numChannels = 0;
+    float sampleRate = 44100.f;
+
+};
+}
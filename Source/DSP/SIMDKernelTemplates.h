@@ -0,0 +1,411 @@
+/*
+  ==============================================================================
+
+    SIMDKernelTemplates.h
+    Created: 21 Oct 2026 11:02:17am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SIMDKernels.h"
+
+// The kernels behind SIMDKernels, written once against a vector type and
+// instantiated by one translation unit per instruction set. Those units are
+// compiled for a CPU this one may not be, so anything they pull in that isn't
+// a template on their own vector type could be emitted with the wrong
+// instructions and picked by the linker for everyone. That is why this file
+// includes nothing but SIMDKernels.h, and why each vector type lives in an
+// anonymous namespace.
+//
+// A vector type provides:
+//   width                  lanes per register
+//   fused                  whether mulAdd and mulSub round once
+//   load, store            unaligned
+//   expand                 a scalar in every lane
+//   +, -, *
+//   mulAdd(a, b, c)        a * b + c, fused where the set has FMA
+//   mulSub(a, b, c)        c - a * b, likewise
+//   sum()                  of the lanes
+//   addInterleaved(d, re, im)  adds re and im to the interleaved complex values at d
+
+namespace xynth
+{
+
+// One table per instruction set, each defined by its own SIMDKernels*.cpp
+extern const SIMDKernels genericKernels;
+#if MODALSHIFT_SIMD_X86
+extern const SIMDKernels sse2Kernels, avx2Kernels, avx512Kernels;
+#endif
+#if MODALSHIFT_SIMD_NEON
+extern const SIMDKernels neonKernels;
+#endif
+
+namespace kernels
+{
+
+//==============================================================================
+// Same recursion as juce::dsp::IIR::Filter, transposed direct form II. Every
+// stage of the cascade keeps its state in registers for the whole block.
+template <typename Vec, int numRegisters, int numStages>
+void biquadGroup(const float* input, float* const* outputs, int numSamples,
+                 const float* coefficients, float* states, int stride,
+                 int firstHarmonic, int endHarmonic) noexcept
+{
+    constexpr int width = Vec::width;
+    constexpr int groupWidth = numRegisters * width;
+    const auto numLanes = groupWidth < endHarmonic - firstHarmonic ? groupWidth : endHarmonic - firstHarmonic;
+
+    Vec b0[numRegisters], b1[numRegisters], b2[numRegisters], a1[numRegisters], a2[numRegisters];
+    Vec z1[numStages][numRegisters], z2[numStages][numRegisters];
+
+    for (int r = 0; r < numRegisters; ++r)
+    {
+        const auto offset = firstHarmonic + r * width;
+        b0[r] = Vec::load(coefficients + offset);
+        b1[r] = Vec::load(coefficients + stride + offset);
+        b2[r] = Vec::load(coefficients + 2 * stride + offset);
+        a1[r] = Vec::load(coefficients + 3 * stride + offset);
+        a2[r] = Vec::load(coefficients + 4 * stride + offset);
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            z1[stage][r] = Vec::load(states + (stage * 2) * stride + offset);
+            z2[stage][r] = Vec::load(states + (stage * 2 + 1) * stride + offset);
+        }
+    }
+
+    alignas(64) float lanes[groupWidth];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto in = Vec::expand(input[i]);
+
+        for (int r = 0; r < numRegisters; ++r)
+        {
+            auto x = in;
+            for (int stage = 0; stage < numStages; ++stage)
+            {
+                const auto y = Vec::mulAdd(x, b0[r], z1[stage][r]);
+                z1[stage][r] = Vec::mulSub(y, a1[r], x * b1[r]) + z2[stage][r];
+                z2[stage][r] = Vec::mulSub(y, a2[r], x * b2[r]);
+                x = y;
+            }
+            x.store(lanes + r * width);
+        }
+
+        for (int lane = 0; lane < numLanes; ++lane)
+            outputs[lane][i] = lanes[lane];
+    }
+
+    // Only write back the lanes in use, so inactive harmonics keep their state
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        for (int index = 0; index < 2; ++index)
+        {
+            auto& z = index == 0 ? z1[stage] : z2[stage];
+            for (int r = 0; r < numRegisters; ++r)
+                z[r].store(lanes + r * width);
+
+            // As juce::dsp::util::snapToZero
+            auto* state = states + (stage * 2 + index) * stride + firstHarmonic;
+            for (int lane = 0; lane < numLanes; ++lane)
+                state[lane] = (lanes[lane] < -1.0e-8f || lanes[lane] > 1.0e-8f) ? lanes[lane] : 0.f;
+        }
+    }
+}
+
+template <typename Vec, int numStages>
+void biquadRange(const float* input, float* const* outputs, int numSamples,
+                 const float* coefficients, float* states, int stride,
+                 int startHarmonic, int endHarmonic) noexcept
+{
+    constexpr int width = Vec::width;
+
+    for (int harmonic = startHarmonic; harmonic < endHarmonic;)
+    {
+        const auto remaining = endHarmonic - harmonic;
+        auto* const* groupOutputs = outputs + (harmonic - startHarmonic);
+
+        if (remaining >= 4 * width)
+        {
+            biquadGroup<Vec, 4, numStages>(input, groupOutputs, numSamples, coefficients, states, stride, harmonic, endHarmonic);
+            harmonic += 4 * width;
+        }
+        else if (remaining > width)
+        {
+            biquadGroup<Vec, 2, numStages>(input, groupOutputs, numSamples, coefficients, states, stride, harmonic, endHarmonic);
+            harmonic += 2 * width;
+        }
+        else
+        {
+            biquadGroup<Vec, 1, numStages>(input, groupOutputs, numSamples, coefficients, states, stride, harmonic, endHarmonic);
+            harmonic += width;
+        }
+    }
+}
+
+template <typename Vec>
+void biquadBank(const float* input, float* const* outputs, int numSamples,
+                const float* coefficients, float* states, int stride,
+                int numStages, int startHarmonic, int endHarmonic) noexcept
+{
+    // The cascade length is a template argument so the stage loop unrolls
+    switch (numStages)
+    {
+        case 1:  biquadRange<Vec, 1>(input, outputs, numSamples, coefficients, states, stride, startHarmonic, endHarmonic); break;
+        case 2:  biquadRange<Vec, 2>(input, outputs, numSamples, coefficients, states, stride, startHarmonic, endHarmonic); break;
+        case 3:  biquadRange<Vec, 3>(input, outputs, numSamples, coefficients, states, stride, startHarmonic, endHarmonic); break;
+        default: biquadRange<Vec, 4>(input, outputs, numSamples, coefficients, states, stride, startHarmonic, endHarmonic); break;
+    }
+}
+
+//==============================================================================
+template <typename Vec, int numRegisters>
+void phasorGroup(float* const* real, float* const* imag, int numSamples,
+                 float* arrays, int stride, int firstHarmonic, int endHarmonic) noexcept
+{
+    constexpr int width = Vec::width;
+    constexpr int groupWidth = numRegisters * width;
+    const auto numLanes = groupWidth < endHarmonic - firstHarmonic ? groupWidth : endHarmonic - firstHarmonic;
+
+    auto* phaseReal = arrays;
+    auto* phaseImag = arrays + stride;
+
+    Vec pr[numRegisters], pi[numRegisters], sr[numRegisters], si[numRegisters];
+    for (int r = 0; r < numRegisters; ++r)
+    {
+        const auto offset = firstHarmonic + r * width;
+        pr[r] = Vec::load(phaseReal + offset);
+        pi[r] = Vec::load(phaseImag + offset);
+        sr[r] = Vec::load(arrays + 2 * stride + offset);
+        si[r] = Vec::load(arrays + 3 * stride + offset);
+    }
+
+    alignas(64) float lanesReal[groupWidth];
+    alignas(64) float lanesImag[groupWidth];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int r = 0; r < numRegisters; ++r)
+        {
+            pr[r].store(lanesReal + r * width);
+            pi[r].store(lanesImag + r * width);
+
+            const auto newReal = Vec::mulSub(pi[r], si[r], pr[r] * sr[r]);
+            pi[r] = Vec::mulAdd(pr[r], si[r], pi[r] * sr[r]);
+            pr[r] = newReal;
+        }
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            real[lane][i] = lanesReal[lane];
+            imag[lane][i] = lanesImag[lane];
+        }
+    }
+
+    // One Newton step towards unit magnitude: p *= (3 - |p|^2) / 2
+    for (int r = 0; r < numRegisters; ++r)
+    {
+        const auto gain = (Vec::expand(3.f) - Vec::mulAdd(pr[r], pr[r], pi[r] * pi[r])) * Vec::expand(0.5f);
+        (pr[r] * gain).store(lanesReal + r * width);
+        (pi[r] * gain).store(lanesImag + r * width);
+    }
+
+    // Only write back the lanes in range, so other ranges can run concurrently
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        phaseReal[firstHarmonic + lane] = lanesReal[lane];
+        phaseImag[firstHarmonic + lane] = lanesImag[lane];
+    }
+}
+
+template <typename Vec>
+void phasorBank(float* const* real, float* const* imag, int numSamples,
+                float* arrays, int stride, int startHarmonic, int endHarmonic) noexcept
+{
+    constexpr int width = Vec::width;
+
+    for (int harmonic = startHarmonic; harmonic < endHarmonic;)
+    {
+        const auto remaining = endHarmonic - harmonic;
+        auto* const* groupReal = real + (harmonic - startHarmonic);
+        auto* const* groupImag = imag + (harmonic - startHarmonic);
+
+        if (remaining >= 4 * width)
+        {
+            phasorGroup<Vec, 4>(groupReal, groupImag, numSamples, arrays, stride, harmonic, endHarmonic);
+            harmonic += 4 * width;
+        }
+        else if (remaining > width)
+        {
+            phasorGroup<Vec, 2>(groupReal, groupImag, numSamples, arrays, stride, harmonic, endHarmonic);
+            harmonic += 2 * width;
+        }
+        else
+        {
+            phasorGroup<Vec, 1>(groupReal, groupImag, numSamples, arrays, stride, harmonic, endHarmonic);
+            harmonic += width;
+        }
+    }
+}
+
+//==============================================================================
+// HilbertProcessor::processSample with the poles spread across lanes and the
+// state held in registers until the end of the block
+template <typename Vec, bool complexInput>
+void hilbert(const float* input, float* outputReal, float* outputImag, int outputStride,
+             int numSamples, const SIMDKernels::HilbertFilter& filter, float* stateReal, float* stateImag) noexcept
+{
+    constexpr int width = Vec::width;
+    constexpr int numRegisters = (SIMDKernels::hilbertOrder + width - 1) / width;
+    static_assert(numRegisters * width <= SIMDKernels::hilbertPaddedOrder, "registers would run past the padding");
+
+    Vec sr[numRegisters], si[numRegisters], pr[numRegisters], pi[numRegisters], cr[numRegisters], ci[numRegisters];
+    for (int r = 0; r < numRegisters; ++r)
+    {
+        const auto offset = r * width;
+        sr[r] = Vec::load(stateReal + offset);
+        si[r] = Vec::load(stateImag + offset);
+        pr[r] = Vec::load(filter.polesReal + offset);
+        pi[r] = Vec::load(filter.polesImag + offset);
+        cr[r] = Vec::load(filter.coeffsReal + offset);
+        ci[r] = Vec::load(filter.coeffsImag + offset);
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float inReal, inImag = 0.f;
+        if constexpr (complexInput)
+        {
+            inReal = input[2 * i];
+            inImag = input[2 * i + 1];
+        }
+        else
+        {
+            inReal = input[i];
+        }
+
+        const auto re = Vec::expand(inReal);
+        auto sumReal = Vec::expand(0.f), sumImag = Vec::expand(0.f);
+
+        for (int r = 0; r < numRegisters; ++r)
+        {
+            auto newReal = Vec::mulAdd(cr[r], re, Vec::mulSub(si[r], pi[r], sr[r] * pr[r]));
+            auto newImag = Vec::mulAdd(ci[r], re, Vec::mulAdd(sr[r], pi[r], si[r] * pr[r]));
+
+            if constexpr (complexInput)
+            {
+                const auto im = Vec::expand(inImag);
+                newReal = Vec::mulSub(ci[r], im, newReal);
+                newImag = Vec::mulAdd(cr[r], im, newImag);
+            }
+
+            sr[r] = newReal;
+            si[r] = newImag;
+            sumReal = sumReal + newReal;
+            sumImag = sumImag + newImag;
+        }
+
+        // Input and output may share memory, so the input is read first
+        outputReal[i * outputStride] = inReal * filter.direct + sumReal.sum();
+        outputImag[i * outputStride] = inImag * filter.direct + sumImag.sum();
+    }
+
+    for (int r = 0; r < numRegisters; ++r)
+    {
+        sr[r].store(stateReal + r * width);
+        si[r].store(stateImag + r * width);
+    }
+}
+
+//==============================================================================
+template <typename Vec>
+void heterodyne(const float* inputReal, const float* inputImag, const float* phasorReal, const float* phasorImag,
+                float* output, int outputStride, const float* gains, int numOutputs, int numSamples) noexcept
+{
+    constexpr int width = Vec::width;
+
+    // One output at a time, so each is a single contiguous pass of multiply-adds.
+    // The product is recomputed for a second output, which only a panned harmonic has.
+    for (int o = 0; o < numOutputs; ++o, output += outputStride)
+    {
+        const auto gain = gains[o];
+        if (gain == 0.f)
+            continue;
+
+        const auto g = Vec::expand(gain);
+
+        int i = 0;
+        for (; i + width <= numSamples; i += width)
+        {
+            const auto re = Vec::load(inputReal + i), im = Vec::load(inputImag + i);
+            const auto pr = Vec::load(phasorReal + i), pi = Vec::load(phasorImag + i);
+            Vec::addInterleaved(output + 2 * i, Vec::mulSub(im, pi, re * pr) * g, Vec::mulAdd(re, pi, im * pr) * g);
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            const auto re = inputReal[i], im = inputImag[i];
+            const auto pr = phasorReal[i], pi = phasorImag[i];
+            output[2 * i] += (re * pr - im * pi) * gain;
+            output[2 * i + 1] += (re * pi + im * pr) * gain;
+        }
+    }
+}
+
+//==============================================================================
+template <typename Vec>
+void sum(float* destination, const float* sources, int sourceStride, int numSources, int numValues) noexcept
+{
+    // Four registers of the destination at a time stay put while every source is added
+    constexpr int width = Vec::width;
+    constexpr int stripWidth = 4 * width;
+
+    if (numSources <= 0)
+    {
+        for (int i = 0; i < numValues; ++i)
+            destination[i] = 0.f;
+        return;
+    }
+
+    int i = 0;
+    for (; i + stripWidth <= numValues; i += stripWidth)
+    {
+        Vec total[4];
+        for (int r = 0; r < 4; ++r)
+            total[r] = Vec::load(sources + i + r * width);
+
+        for (int source = 1; source < numSources; ++source)
+            for (int r = 0; r < 4; ++r)
+                total[r] = total[r] + Vec::load(sources + source * sourceStride + i + r * width);
+
+        for (int r = 0; r < 4; ++r)
+            total[r].store(destination + i + r * width);
+    }
+
+    for (; i < numValues; ++i)
+    {
+        auto total = sources[i];
+        for (int source = 1; source < numSources; ++source)
+            total += sources[source * sourceStride + i];
+        destination[i] = total;
+    }
+}
+
+//==============================================================================
+template <typename Vec>
+constexpr SIMDKernels makeKernels(SIMDKernels::InstructionSet instructionSet, const char* name) noexcept
+{
+    return { instructionSet, name, Vec::width, Vec::fused,
+             &biquadBank<Vec>,
+             &phasorBank<Vec>,
+             &hilbert<Vec, false>, &hilbert<Vec, true>,
+             &heterodyne<Vec>,
+             &sum<Vec> };
+}
+
+} // namespace kernels
+} // namespace xynth
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    SIMDKernels.cpp
+    Created: 21 Oct 2026 11:02:17am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "SIMDKernels.h"
+#include "SIMDKernelTemplates.h"
+
+#include <JuceHeader.h>
+
+namespace xynth
+{
+namespace
+{
+
+// The fallback for targets with no SIMD set built in, one lane at a time
+struct Scalar
+{
+    static constexpr int width = 1;
+    static constexpr bool fused = false;
+    float value;
+
+    static Scalar load(const float* source) noexcept            { return { *source }; }
+    void store(float* destination) const noexcept               { *destination = value; }
+    static Scalar expand(float scalar) noexcept                 { return { scalar }; }
+
+    Scalar operator+ (Scalar other) const noexcept              { return { value + other.value }; }
+    Scalar operator- (Scalar other) const noexcept              { return { value - other.value }; }
+    Scalar operator* (Scalar other) const noexcept              { return { value * other.value }; }
+
+    static Scalar mulAdd(Scalar a, Scalar b, Scalar c) noexcept { return { a.value * b.value + c.value }; }
+    static Scalar mulSub(Scalar a, Scalar b, Scalar c) noexcept { return { c.value - a.value * b.value }; }
+
+    float sum() const noexcept                                  { return value; }
+
+    static void addInterleaved(float* destination, Scalar real, Scalar imag) noexcept
+    {
+        destination[0] += real.value;
+        destination[1] += imag.value;
+    }
+};
+
+bool isSupported(SIMDKernels::InstructionSet set) noexcept
+{
+    using Set = SIMDKernels::InstructionSet;
+
+    switch (set)
+    {
+        case Set::generic:  return true;
+       #if MODALSHIFT_SIMD_X86
+        case Set::sse2:     return juce::SystemStats::hasSSE2();
+        case Set::avx2:     return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+        case Set::avx512:   return juce::SystemStats::hasAVX512F();
+       #endif
+       #if MODALSHIFT_SIMD_NEON
+        case Set::neon:     return true;
+       #endif
+        default:            return false;
+    }
+}
+
+const SIMDKernels* getTable(SIMDKernels::InstructionSet set) noexcept
+{
+    using Set = SIMDKernels::InstructionSet;
+
+    switch (set)
+    {
+        case Set::generic:  return &genericKernels;
+       #if MODALSHIFT_SIMD_X86
+        case Set::sse2:     return &sse2Kernels;
+        case Set::avx2:     return &avx2Kernels;
+        case Set::avx512:   return &avx512Kernels;
+       #endif
+       #if MODALSHIFT_SIMD_NEON
+        case Set::neon:     return &neonKernels;
+       #endif
+        default:            return nullptr;
+    }
+}
+
+std::atomic<const SIMDKernels*>& getCurrent() noexcept
+{
+    // Detected on first use, after which get() is one load
+    static std::atomic<const SIMDKernels*> current { SIMDKernels::find(SIMDKernels::getBest()) };
+    return current;
+}
+
+} // namespace
+
+const SIMDKernels genericKernels = kernels::makeKernels<Scalar>(SIMDKernels::InstructionSet::generic, "generic");
+
+const SIMDKernels& SIMDKernels::get() noexcept
+{
+    return *getCurrent().load(std::memory_order_relaxed);
+}
+
+SIMDKernels::InstructionSet SIMDKernels::getBest() noexcept
+{
+    // Widest first
+    for (const auto set : { InstructionSet::avx512, InstructionSet::avx2, InstructionSet::neon, InstructionSet::sse2 })
+        if (find(set) != nullptr)
+            return set;
+
+    return InstructionSet::generic;
+}
+
+const SIMDKernels* SIMDKernels::find(InstructionSet set) noexcept
+{
+    return isSupported(set) ? getTable(set) : nullptr;
+}
+
+const SIMDKernels* SIMDKernels::find(const char* name) noexcept
+{
+    for (int set = 0; set < static_cast<int>(InstructionSet::numInstructionSets); ++set)
+        if (const auto* kernels = getTable(static_cast<InstructionSet>(set)); kernels != nullptr && std::strcmp(kernels->name, name) == 0)
+            return find(kernels->instructionSet);
+
+    return nullptr;
+}
+
+bool SIMDKernels::use(InstructionSet set) noexcept
+{
+    const auto* kernels = find(set);
+    if (kernels == nullptr)
+        return false;
+
+    getCurrent().store(kernels, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace xynth
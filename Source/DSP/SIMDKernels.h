@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    SIMDKernels.h
+    Created: 21 Oct 2026 11:02:17am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// No JUCE in here: this is included by the translation units that are built
+// for instruction sets the CPU may not have, see SIMDKernelTemplates.h.
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+ #define MODALSHIFT_SIMD_X86 1
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__) || defined (_M_ARM64)
+ #define MODALSHIFT_SIMD_NEON 1
+#endif
+
+#ifndef MODALSHIFT_SIMD_X86
+ #define MODALSHIFT_SIMD_X86 0
+#endif
+
+#ifndef MODALSHIFT_SIMD_NEON
+ #define MODALSHIFT_SIMD_NEON 0
+#endif
+
+namespace xynth
+{
+
+// The inner loops of the engine, built once per instruction set. One binary
+// runs everywhere and still uses the widest registers the CPU has: the best
+// set is picked from CPUID the first time get() is called, and the banks go
+// through its function pointers, once per call rather than per sample.
+//
+// Every set works on the same memory layouts, so state survives a switch,
+// but the wider ones fuse multiplies and adds, so results differ in the last
+// bits from one set to another.
+struct SIMDKernels
+{
+    enum class InstructionSet
+    {
+        generic,    // plain C++, one lane
+        sse2,
+        avx2,       // with FMA
+        avx512,
+        neon,
+        numInstructionSets
+    };
+
+    // AVX-512's. Arrays the kernels walk are padded to whole groups of this.
+    static constexpr int maxLaneWidth = 16;
+    static constexpr int maxGroupWidth = 4 * maxLaneWidth;
+
+    static constexpr int hilbertOrder = 12;
+    static constexpr int hilbertPaddedOrder = (hilbertOrder + maxLaneWidth - 1) / maxLaneWidth * maxLaneWidth;
+
+    // What the Hilbert kernels need from a HilbertProcessor. Each array holds
+    // hilbertPaddedOrder values, zero past hilbertOrder.
+    struct HilbertFilter
+    {
+        const float* coeffsReal;
+        const float* coeffsImag;
+        const float* polesReal;
+        const float* polesImag;
+        float direct;
+    };
+
+    // BiquadBank::process for one channel. coefficients holds b0, b1, b2, a1 and a2
+    // stride floats apart; states holds the channel's z1 and z2 for each stage, the same.
+    using BiquadKernel = void (*)(const float* input, float* const* outputs, int numSamples,
+                                  const float* coefficients, float* states, int stride,
+                                  int numStages, int startHarmonic, int endHarmonic) noexcept;
+
+    // PhasorBank::process. arrays holds the phase then the step, real and imaginary,
+    // stride floats apart.
+    using PhasorKernel = void (*)(float* const* real, float* const* imag, int numSamples,
+                                  float* arrays, int stride, int startHarmonic, int endHarmonic) noexcept;
+
+    // HilbertProcessor::processBlock. Output i goes to outputReal[i * outputStride] and
+    // outputImag[i * outputStride], so it can be split or interleaved. Complex input is interleaved.
+    using HilbertKernel = void (*)(const float* input, float* outputReal, float* outputImag, int outputStride,
+                                   int numSamples, const HilbertFilter& filter, float* stateReal, float* stateImag) noexcept;
+
+    // Multiplies an analytic signal by a phasor and adds it, times gains[o], to each of
+    // numOutputs interleaved complex outputs, outputStride floats apart. Outputs with a
+    // gain of zero aren't touched.
+    using HeterodyneKernel = void (*)(const float* inputReal, const float* inputImag,
+                                      const float* phasorReal, const float* phasorImag,
+                                      float* output, int outputStride, const float* gains,
+                                      int numOutputs, int numSamples) noexcept;
+
+    // Writes the sum of numSources arrays of numValues, sourceStride floats apart, to
+    // destination. Always adds in source order, so the result doesn't depend on the lane width.
+    using SumKernel = void (*)(float* destination, const float* sources, int sourceStride,
+                               int numSources, int numValues) noexcept;
+
+    InstructionSet instructionSet;
+    const char* name;
+    int laneWidth;
+    bool fused;     // multiply-adds round once, as FMA does
+
+    BiquadKernel biquadBank;
+    PhasorKernel phasorBank;
+    HilbertKernel hilbert, hilbertComplex;
+    HeterodyneKernel heterodyne;
+    SumKernel sum;
+
+    // The kernels in use: the best set this CPU supports, unless use() picked another
+    static const SIMDKernels& get() noexcept;
+    static InstructionSet getBest() noexcept;
+
+    // Null where the set isn't built for this architecture or the CPU lacks it
+    static const SIMDKernels* find(InstructionSet set) noexcept;
+    static const SIMDKernels* find(const char* name) noexcept;
+
+    // Forces a set, for benchmarks and validation. Only switch while nothing is
+    // processing. Returns false, changing nothing, if find() can't have it.
+    static bool use(InstructionSet set) noexcept;
+};
+
+}
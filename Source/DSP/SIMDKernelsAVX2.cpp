@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    SIMDKernelsAVX2.cpp
+    Created: 21 Oct 2026 11:02:17am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "SIMDKernels.h"
+
+#if MODALSHIFT_SIMD_X86
+
+#include <immintrin.h>
+
+// Everything below is built for AVX2 and FMA, whatever the rest of the
+// project targets. Only called once SIMDKernels has seen both in CPUID.
+#if defined (__clang__)
+ #pragma clang attribute push (__attribute__((target ("avx2,fma"))), apply_to = function)
+#elif defined (__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target ("avx2,fma")
+#endif
+
+#include "SIMDKernelTemplates.h"
+
+namespace xynth
+{
+namespace
+{
+
+struct AVX2
+{
+    static constexpr int width = 8;
+    static constexpr bool fused = true;
+    __m256 value;
+
+    static AVX2 load(const float* source) noexcept       { return { _mm256_loadu_ps(source) }; }
+    void store(float* destination) const noexcept        { _mm256_storeu_ps(destination, value); }
+    static AVX2 expand(float scalar) noexcept            { return { _mm256_set1_ps(scalar) }; }
+
+    AVX2 operator+ (AVX2 other) const noexcept           { return { _mm256_add_ps(value, other.value) }; }
+    AVX2 operator- (AVX2 other) const noexcept           { return { _mm256_sub_ps(value, other.value) }; }
+    AVX2 operator* (AVX2 other) const noexcept           { return { _mm256_mul_ps(value, other.value) }; }
+
+    static AVX2 mulAdd(AVX2 a, AVX2 b, AVX2 c) noexcept  { return { _mm256_fmadd_ps(a.value, b.value, c.value) }; }
+    static AVX2 mulSub(AVX2 a, AVX2 b, AVX2 c) noexcept  { return { _mm256_fnmadd_ps(a.value, b.value, c.value) }; }
+
+    float sum() const noexcept
+    {
+        const auto halves = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+        const auto pairs = _mm_add_ps(halves, _mm_movehl_ps(halves, halves));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    static void addInterleaved(float* destination, AVX2 real, AVX2 imag) noexcept
+    {
+        // The unpacks work within 128-bit halves, so the halves need putting back in order
+        const auto low = _mm256_unpacklo_ps(real.value, imag.value);
+        const auto high = _mm256_unpackhi_ps(real.value, imag.value);
+        const auto first = _mm256_permute2f128_ps(low, high, 0x20);
+        const auto second = _mm256_permute2f128_ps(low, high, 0x31);
+
+        _mm256_storeu_ps(destination, _mm256_add_ps(_mm256_loadu_ps(destination), first));
+        _mm256_storeu_ps(destination + 8, _mm256_add_ps(_mm256_loadu_ps(destination + 8), second));
+    }
+};
+
+} // namespace
+
+const SIMDKernels avx2Kernels = kernels::makeKernels<AVX2>(SIMDKernels::InstructionSet::avx2, "avx2");
+
+} // namespace xynth
+
+#if defined (__clang__)
+ #pragma clang attribute pop
+#elif defined (__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#endif
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    SIMDKernelsAVX512.cpp
+    Created: 21 Oct 2026 11:02:17am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "SIMDKernels.h"
+
+#if MODALSHIFT_SIMD_X86
+
+#include <immintrin.h>
+
+// Everything below is built for AVX-512F, whatever the rest of the project
+// targets. Only called once SIMDKernels has seen it in CPUID.
+#if defined (__clang__)
+ #pragma clang attribute push (__attribute__((target ("avx512f,avx2,fma"))), apply_to = function)
+#elif defined (__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target ("avx512f,avx2,fma")
+#endif
+
+#include "SIMDKernelTemplates.h"
+
+namespace xynth
+{
+namespace
+{
+
+struct AVX512
+{
+    static constexpr int width = 16;
+    static constexpr bool fused = true;
+    __m512 value;
+
+    static AVX512 load(const float* source) noexcept             { return { _mm512_loadu_ps(source) }; }
+    void store(float* destination) const noexcept                { _mm512_storeu_ps(destination, value); }
+    static AVX512 expand(float scalar) noexcept                  { return { _mm512_set1_ps(scalar) }; }
+
+    AVX512 operator+ (AVX512 other) const noexcept               { return { _mm512_add_ps(value, other.value) }; }
+    AVX512 operator- (AVX512 other) const noexcept               { return { _mm512_sub_ps(value, other.value) }; }
+    AVX512 operator* (AVX512 other) const noexcept               { return { _mm512_mul_ps(value, other.value) }; }
+
+    static AVX512 mulAdd(AVX512 a, AVX512 b, AVX512 c) noexcept  { return { _mm512_fmadd_ps(a.value, b.value, c.value) }; }
+    static AVX512 mulSub(AVX512 a, AVX512 b, AVX512 c) noexcept  { return { _mm512_fnmadd_ps(a.value, b.value, c.value) }; }
+
+    float sum() const noexcept                                   { return _mm512_reduce_add_ps(value); }
+
+    static void addInterleaved(float* destination, AVX512 real, AVX512 imag) noexcept
+    {
+        // 128-bit lane k of low holds pairs 4k and 4k + 1, of high 4k + 2 and 4k + 3
+        const auto low = _mm512_unpacklo_ps(real.value, imag.value);
+        const auto high = _mm512_unpackhi_ps(real.value, imag.value);
+
+        auto first = _mm512_shuffle_f32x4(low, high, _MM_SHUFFLE(1, 0, 1, 0));
+        auto second = _mm512_shuffle_f32x4(low, high, _MM_SHUFFLE(3, 2, 3, 2));
+        first = _mm512_shuffle_f32x4(first, first, _MM_SHUFFLE(3, 1, 2, 0));
+        second = _mm512_shuffle_f32x4(second, second, _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm512_storeu_ps(destination, _mm512_add_ps(_mm512_loadu_ps(destination), first));
+        _mm512_storeu_ps(destination + 16, _mm512_add_ps(_mm512_loadu_ps(destination + 16), second));
+    }
+};
+
+} // namespace
+
+const SIMDKernels avx512Kernels = kernels::makeKernels<AVX512>(SIMDKernels::InstructionSet::avx512, "avx512");
+
+} // namespace xynth
+
+#if defined (__clang__)
+ #pragma clang attribute pop
+#elif defined (__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    SIMDKernelsNEON.cpp
+    Created: 21 Oct 2026 11:02:17am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "SIMDKernels.h"
+
+#if MODALSHIFT_SIMD_NEON
+
+#include <arm_neon.h>
+
+// NEON is part of every ARM target this builds for, so unlike the x86 sets
+// there is nothing to detect and no target to switch to
+#include "SIMDKernelTemplates.h"
+
+namespace xynth
+{
+namespace
+{
+
+struct NEON
+{
+    static constexpr int width = 4;
+   #if defined (__aarch64__) || defined (_M_ARM64)
+    static constexpr bool fused = true;
+   #else
+    static constexpr bool fused = false;
+   #endif
+    float32x4_t value;
+
+    static NEON load(const float* source) noexcept       { return { vld1q_f32(source) }; }
+    void store(float* destination) const noexcept        { vst1q_f32(destination, value); }
+    static NEON expand(float scalar) noexcept            { return { vdupq_n_f32(scalar) }; }
+
+    NEON operator+ (NEON other) const noexcept           { return { vaddq_f32(value, other.value) }; }
+    NEON operator- (NEON other) const noexcept           { return { vsubq_f32(value, other.value) }; }
+    NEON operator* (NEON other) const noexcept           { return { vmulq_f32(value, other.value) }; }
+
+   #if defined (__aarch64__) || defined (_M_ARM64)
+    static NEON mulAdd(NEON a, NEON b, NEON c) noexcept  { return { vfmaq_f32(c.value, a.value, b.value) }; }
+    static NEON mulSub(NEON a, NEON b, NEON c) noexcept  { return { vfmsq_f32(c.value, a.value, b.value) }; }
+    float sum() const noexcept                           { return vaddvq_f32(value); }
+   #else
+    static NEON mulAdd(NEON a, NEON b, NEON c) noexcept  { return { vmlaq_f32(c.value, a.value, b.value) }; }
+    static NEON mulSub(NEON a, NEON b, NEON c) noexcept  { return { vmlsq_f32(c.value, a.value, b.value) }; }
+
+    float sum() const noexcept
+    {
+        const auto halves = vadd_f32(vget_low_f32(value), vget_high_f32(value));
+        return vget_lane_f32(vpadd_f32(halves, halves), 0);
+    }
+   #endif
+
+    static void addInterleaved(float* destination, NEON real, NEON imag) noexcept
+    {
+        auto pairs = vld2q_f32(destination);
+        pairs.val[0] = vaddq_f32(pairs.val[0], real.value);
+        pairs.val[1] = vaddq_f32(pairs.val[1], imag.value);
+        vst2q_f32(destination, pairs);
+    }
+};
+
+} // namespace
+
+const SIMDKernels neonKernels = kernels::makeKernels<NEON>(SIMDKernels::InstructionSet::neon, "neon");
+
+} // namespace xynth
+
+#endif
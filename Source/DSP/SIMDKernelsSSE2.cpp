@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    SIMDKernelsSSE2.cpp
+    Created: 21 Oct 2026 11:02:17am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "SIMDKernels.h"
+
+#if MODALSHIFT_SIMD_X86
+
+#include <immintrin.h>
+
+// Everything below is built for SSE2, which 32-bit targets don't assume
+#if defined (__clang__)
+ #pragma clang attribute push (__attribute__((target ("sse2"))), apply_to = function)
+#elif defined (__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target ("sse2")
+#endif
+
+#include "SIMDKernelTemplates.h"
+
+namespace xynth
+{
+namespace
+{
+
+struct SSE2
+{
+    static constexpr int width = 4;
+    static constexpr bool fused = false;
+    __m128 value;
+
+    static SSE2 load(const float* source) noexcept       { return { _mm_loadu_ps(source) }; }
+    void store(float* destination) const noexcept        { _mm_storeu_ps(destination, value); }
+    static SSE2 expand(float scalar) noexcept            { return { _mm_set1_ps(scalar) }; }
+
+    SSE2 operator+ (SSE2 other) const noexcept           { return { _mm_add_ps(value, other.value) }; }
+    SSE2 operator- (SSE2 other) const noexcept           { return { _mm_sub_ps(value, other.value) }; }
+    SSE2 operator* (SSE2 other) const noexcept           { return { _mm_mul_ps(value, other.value) }; }
+
+    static SSE2 mulAdd(SSE2 a, SSE2 b, SSE2 c) noexcept  { return { _mm_add_ps(_mm_mul_ps(a.value, b.value), c.value) }; }
+    static SSE2 mulSub(SSE2 a, SSE2 b, SSE2 c) noexcept  { return { _mm_sub_ps(c.value, _mm_mul_ps(a.value, b.value)) }; }
+
+    float sum() const noexcept
+    {
+        const auto pairs = _mm_add_ps(value, _mm_movehl_ps(value, value));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    static void addInterleaved(float* destination, SSE2 real, SSE2 imag) noexcept
+    {
+        _mm_storeu_ps(destination, _mm_add_ps(_mm_loadu_ps(destination), _mm_unpacklo_ps(real.value, imag.value)));
+        _mm_storeu_ps(destination + 4, _mm_add_ps(_mm_loadu_ps(destination + 4), _mm_unpackhi_ps(real.value, imag.value)));
+    }
+};
+
+} // namespace
+
+const SIMDKernels sse2Kernels = kernels::makeKernels<SSE2>(SIMDKernels::InstructionSet::sse2, "sse2");
+
+} // namespace xynth
+
+#if defined (__clang__)
+ #pragma clang attribute pop
+#elif defined (__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#endif
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    StageProfiler.cpp
+    Created: 19 Oct 2026 4:12:50pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "StageProfiler.h"
+
+namespace xynth
+{
+
+double StageProfiler::Snapshot::getLoad(Stage stage) const noexcept
+{
+    if (numSamples == 0 || sampleRate <= 0.0)
+        return 0.0;
+
+    return totalSeconds[static_cast<size_t>(stage)] * sampleRate / static_cast<double>(numSamples);
+}
+
+juce::String StageProfiler::Snapshot::toString() const
+{
+    juce::String result;
+    result << numBlocks << " blocks, " << numSamples << " samples:";
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        const auto s = static_cast<Stage>(stage);
+        result << " " << getStageName(s) << " " << juce::String(getLoad(s) * 100.0, 2) << "%"
+               << " (max " << juce::String(maxBlockSeconds[static_cast<size_t>(stage)] * 1.0e6, 1) << " us)";
+    }
+
+    return result;
+}
+
+const char* StageProfiler::getStageName(Stage stage) noexcept
+{
+    switch (stage)
+    {
+        case Coefficients:  return "coefficients";
+        case Bandpass:      return "bandpass";
+        case Hilbert:       return "hilbert";
+        case Heterodyne:    return "heterodyne";
+        case MixDown:       return "mixdown";
+        default:            return "unknown";
+    }
+}
+
+#if MODALSHIFT_PROFILE_STAGES
+
+void StageProfiler::prepare(double newSampleRate) noexcept
+{
+    sampleRate.store(newSampleRate, std::memory_order_relaxed);
+}
+
+void StageProfiler::add(const std::array<juce::int64, numStages>& ticks) noexcept
+{
+    for (size_t stage = 0; stage < ticks.size(); ++stage)
+        if (ticks[stage] != 0)
+            blockTicks[stage].fetch_add(ticks[stage], std::memory_order_relaxed);
+}
+
+void StageProfiler::endBlock(int numSamples) noexcept
+{
+    for (size_t stage = 0; stage < blockTicks.size(); ++stage)
+    {
+        const auto ticks = blockTicks[stage].exchange(0, std::memory_order_relaxed);
+        lastBlockTicks[stage] = ticks;
+        windowTicks[stage].fetch_add(ticks, std::memory_order_relaxed);
+
+        auto max = windowMaxTicks[stage].load(std::memory_order_relaxed);
+        while (ticks > max && ! windowMaxTicks[stage].compare_exchange_weak(max, ticks, std::memory_order_relaxed))
+            ;
+    }
+
+    windowSamples.fetch_add(numSamples, std::memory_order_relaxed);
+    windowBlocks.fetch_add(1, std::memory_order_release);
+}
+
+StageProfiler::Snapshot StageProfiler::collect() noexcept
+{
+    // The fields are taken one at a time, so a block ending meanwhile may be
+    // split across this window and the next. Over a window that doesn't matter.
+    Snapshot snapshot;
+    snapshot.numBlocks = windowBlocks.exchange(0, std::memory_order_acquire);
+    snapshot.numSamples = windowSamples.exchange(0, std::memory_order_relaxed);
+    snapshot.sampleRate = sampleRate.load(std::memory_order_relaxed);
+
+    const auto secondsPerTick = 1.0 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    for (size_t stage = 0; stage < windowTicks.size(); ++stage)
+    {
+        snapshot.totalSeconds[stage] = static_cast<double>(windowTicks[stage].exchange(0, std::memory_order_relaxed)) * secondsPerTick;
+        snapshot.maxBlockSeconds[stage] = static_cast<double>(windowMaxTicks[stage].exchange(0, std::memory_order_relaxed)) * secondsPerTick;
+    }
+
+    return snapshot;
+}
+
+double StageProfiler::getLastBlockSeconds(Stage stage) const noexcept
+{
+    return static_cast<double>(lastBlockTicks[static_cast<size_t>(stage)])
+         / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+}
+
+#endif
+
+} // namespace xynth
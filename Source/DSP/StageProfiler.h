@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 19 Oct 2026 4:12:50pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Per-stage CPU timing for HarmonicEngine. Off by default: with it off every
+// call below is an empty inline function and no clock is ever read. It changes
+// class layouts, so define it the same way for every file that includes this.
+#ifndef MODALSHIFT_PROFILE_STAGES
+ #define MODALSHIFT_PROFILE_STAGES 0
+#endif
+
+namespace xynth
+{
+
+// Accumulates how long each stage of the engine takes. Stages are timed with
+// Laps on whichever threads render them, so totals are CPU time summed over
+// every thread, not wall time. The thread that calls process() folds each
+// block into a window of totals and per-block maxima held in atomics, which
+// the message thread takes with collect(), starting a new window.
+class StageProfiler
+{
+public:
+    enum Stage
+    {
+        Coefficients,
+        // Biquad cascades, or the resonators in ComplexResonator mode
+        Bandpass,
+        Hilbert,
+        // Phasors and the complex multiply
+        Heterodyne,
+        // Moving chunks in and out, summing the groups' partials and anti-aliasing
+        MixDown,
+        numStages
+    };
+
+    static constexpr bool enabled = MODALSHIFT_PROFILE_STAGES != 0;
+
+    struct Snapshot
+    {
+        int numBlocks = 0;
+        juce::int64 numSamples = 0;
+        double sampleRate = 0.0;
+        std::array<double, numStages> totalSeconds {}, maxBlockSeconds {};
+
+        // A stage's CPU time as a fraction of the audio it processed
+        double getLoad(Stage stage) const noexcept;
+        juce::String toString() const;
+    };
+
+    // Times consecutive stages on one thread: record() charges the time since
+    // the previous record() (or construction, or restart()) to a stage. Totals
+    // stay local until flush() or destruction, so the hot path touches no atomics.
+    class Lap
+    {
+    public:
+       #if MODALSHIFT_PROFILE_STAGES
+        explicit Lap(StageProfiler& p) noexcept : profiler(p), last(juce::Time::getHighResolutionTicks()) {}
+        ~Lap() { flush(); }
+
+        void flush() noexcept
+        {
+            profiler.add(ticks);
+            ticks = {};
+        }
+
+        void record(Stage stage) noexcept
+        {
+            const auto now = juce::Time::getHighResolutionTicks();
+            ticks[static_cast<size_t>(stage)] += now - last;
+            last = now;
+        }
+
+        void restart() noexcept { last = juce::Time::getHighResolutionTicks(); }
+       #else
+        explicit Lap(StageProfiler&) noexcept {}
+
+        void flush() noexcept {}
+        void record(Stage) noexcept {}
+        void restart() noexcept {}
+       #endif
+
+    private:
+       #if MODALSHIFT_PROFILE_STAGES
+        StageProfiler& profiler;
+        juce::int64 last;
+        std::array<juce::int64, numStages> ticks {};
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE(Lap)
+    };
+
+public:
+    StageProfiler() = default;
+
+   #if MODALSHIFT_PROFILE_STAGES
+    void prepare(double sampleRate) noexcept;
+
+    // Call from the thread that ran the block, once all its Laps are flushed
+    void endBlock(int numSamples) noexcept;
+
+    // Takes the window since the last call. Don't call from the audio thread.
+    Snapshot collect() noexcept;
+
+    // The block endBlock() last closed, for the thread that called it
+    double getLastBlockSeconds(Stage stage) const noexcept;
+   #else
+    void prepare(double) noexcept {}
+    void endBlock(int) noexcept {}
+    Snapshot collect() noexcept { return {}; }
+    double getLastBlockSeconds(Stage) const noexcept { return 0.0; }
+   #endif
+
+    static const char* getStageName(Stage stage) noexcept;
+
+private:
+   #if MODALSHIFT_PROFILE_STAGES
+    using Counters = std::array<std::atomic<juce::int64>, numStages>;
+
+    void add(const std::array<juce::int64, numStages>& ticks) noexcept;
+
+    std::atomic<double> sampleRate { 0.0 };
+    // The block in progress, added to by every thread that renders it
+    Counters blockTicks {};
+    // The window since the last collect()
+    Counters windowTicks {}, windowMaxTicks {};
+    std::atomic<int> windowBlocks { 0 };
+    std::atomic<juce::int64> windowSamples { 0 };
+    std::array<juce::int64, numStages> lastBlockTicks {};
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE(StageProfiler)
+};
+}
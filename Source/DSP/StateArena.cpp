@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    StateArena.cpp
+    Created: 20 Oct 2026 5:26:44pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "StateArena.h"
+
+namespace xynth
+{
+
+void StateArena::allocate()
+{
+    if (data != nullptr && size <= capacity)
+    {
+        reset();
+        return;
+    }
+
+    // Fresh pages from calloc are zero without being touched, so the part a
+    // smaller harmonic count never reaches costs no time to clear
+    storage.calloc(size + alignment);
+    data = juce::snapPointerToAlignment(storage.get(), alignment);
+    capacity = size;
+}
+
+void StateArena::reset() noexcept
+{
+    if (data != nullptr)
+        std::memset(data, 0, size);
+}
+
+} // namespace xynth
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    StateArena.h
+    Created: 20 Oct 2026 5:26:44pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace xynth
+{
+
+// One cache-line-aligned allocation holding the running state of several
+// banks, so a process() call walks one contiguous block rather than a
+// scattering of small heap blocks, and clearing all of it is a single memset.
+// Only state whose reset value is all zero bits belongs here.
+//
+// The layout is built in two passes: every user reserve()s its region while it
+// prepares, then the owner calls allocate(). A Region only points at memory
+// once that has happened, and follows the arena if it's allocated again.
+class StateArena
+{
+public:
+    static constexpr size_t alignment = 64;
+
+    template <typename Type>
+    class Region
+    {
+    public:
+        Region() = default;
+
+        Type* get() const noexcept
+        {
+            jassert(arena != nullptr && arena->data != nullptr);
+            return reinterpret_cast<Type*>(arena->data + offset);
+        }
+
+    private:
+        friend class StateArena;
+        Region(const StateArena* a, size_t o) noexcept : arena(a), offset(o) {}
+
+        const StateArena* arena = nullptr;
+        size_t offset = 0;
+    };
+
+public:
+    StateArena() = default;
+
+    // Forgets every region, ready for a new layout
+    void clear() noexcept { size = 0; }
+
+    // Adds a region for numElements of Type, starting on a cache line
+    template <typename Type>
+    Region<Type> reserve(size_t numElements) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<Type>, "the arena is reset with memset");
+        static_assert(alignof(Type) <= alignment, "regions only start on a cache line");
+
+        const Region<Type> region { this, size };
+        size += (numElements * sizeof(Type) + alignment - 1) / alignment * alignment;
+        return region;
+    }
+
+    // Allocates what's been reserved, zeroed. Memory from an earlier layout is
+    // kept if the new one fits, so preparing again with fewer harmonics or
+    // channels doesn't allocate.
+    void allocate();
+    void reset() noexcept;
+
+    size_t getSizeInBytes() const noexcept { return size; }
+
+private:
+    juce::HeapBlock<char> storage;
+    char* data = nullptr;
+    size_t size = 0, capacity = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(StateArena)
+};
+}
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    WorkerPool.cpp
+    Created: 18 Oct 2026 9:41:27am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "WorkerPool.h"
+
+namespace xynth
+{
+
+class WorkerPool::Worker : public juce::Thread
+{
+public:
+    Worker(WorkerPool& p, int index) : juce::Thread("ModalShift worker"), pool(p), threadIndex(index) {}
+
+    void run() override
+    {
+        // The audio thread runs with denormals flushed, and a group has to round
+        // the same whichever thread renders it
+        juce::ScopedNoDenormals noDenormals;
+
+        while (! threadShouldExit())
+        {
+            while (pool.runNextTask(threadIndex))
+                ;
+
+            // Until run() or setNumWorkers() notifies. A notify that came while the
+            // tasks above were running leaves the event set, so none are missed.
+            wait(-1);
+        }
+    }
+
+private:
+    WorkerPool& pool;
+    const int threadIndex;
+};
+
+WorkerPool::WorkerPool() = default;
+
+WorkerPool::~WorkerPool()
+{
+    setNumWorkers(0);
+}
+
+void WorkerPool::setNumWorkers(int numWorkers)
+{
+    numWorkers = juce::jmax(0, numWorkers);
+
+    while (getNumWorkers() > numWorkers)
+    {
+        workers.back()->signalThreadShouldExit();
+        workers.back()->notify();
+        workers.back()->stopThread(1000);
+        workers.pop_back();
+    }
+
+    while (getNumWorkers() < numWorkers)
+    {
+        workers.push_back(std::make_unique<Worker>(*this, getNumWorkers() + 1));
+        workers.back()->startRealtimeThread(juce::Thread::RealtimeOptions{});
+    }
+}
+
+void WorkerPool::run(Job& job, int numTasks) noexcept
+{
+    if (numTasks <= 0)
+        return;
+
+    currentJob.store(&job, std::memory_order_relaxed);
+    numTasksRemaining.store(numTasks, std::memory_order_relaxed);
+    // Publishes the job and everything the caller wrote before calling run()
+    taskState.store(static_cast<uint64_t>(numTasks) << 32, std::memory_order_release);
+
+    // The caller takes tasks too, so only wake the workers there's work for
+    const auto numToWake = juce::jmin(getNumWorkers(), numTasks - 1);
+    for (int i = 0; i < numToWake; ++i)
+        workers[static_cast<size_t>(i)]->notify();
+
+    while (runNextTask(0))
+        ;
+
+    // Only tasks already claimed by a worker can still be running
+    while (numTasksRemaining.load(std::memory_order_acquire) > 0)
+        juce::Thread::yield();
+}
+
+bool WorkerPool::runNextTask(int threadIndex) noexcept
+{
+    auto state = taskState.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        const auto taskIndex = static_cast<uint32_t>(state);
+        const auto numTasks = static_cast<uint32_t>(state >> 32);
+
+        if (taskIndex >= numTasks)
+            return false;
+
+        // A successful exchange means this index belongs to the job that is still running
+        if (taskState.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            currentJob.load(std::memory_order_relaxed)->runTask(static_cast<int>(taskIndex), threadIndex);
+            numTasksRemaining.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+} // namespace xynth
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    WorkerPool.h
+    Created: 18 Oct 2026 9:41:27am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace xynth
+{
+
+// A small pool of worker threads for splitting audio-thread work into tasks.
+// run() never allocates: tasks are claimed through a single atomic, and the
+// calling thread claims tasks too, so a job completes even if no worker wakes
+// in time. Workers wait on their thread's event between jobs, which run()
+// signals, so an idle pool costs nothing. Workers flush denormals like the
+// audio thread does, so which thread runs a task doesn't change its output.
+class WorkerPool
+{
+public:
+    struct Job
+    {
+        virtual ~Job() = default;
+        // threadIndex is 0 on the thread that called run() and 1 to getNumWorkers()
+        // on the workers, for jobs that keep scratch per thread
+        virtual void runTask(int taskIndex, int threadIndex) noexcept = 0;
+    };
+
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    // Starts or stops threads, so call this off the audio thread
+    void setNumWorkers(int numWorkers);
+    int getNumWorkers() const noexcept { return static_cast<int>(workers.size()); }
+    // The workers and the caller of run()
+    int getNumThreads() const noexcept { return getNumWorkers() + 1; }
+
+    // Runs job.runTask(i) for every i in [0, numTasks) and returns when all are done.
+    // Which thread runs which task is not fixed, so tasks must not share outputs.
+    void run(Job& job, int numTasks) noexcept;
+
+private:
+    class Worker;
+
+    // Claims and runs one task of the current job, returns false if none are left
+    bool runNextTask(int threadIndex) noexcept;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Low 32 bits: next task index, high 32 bits: number of tasks
+    std::atomic<uint64_t> taskState { 0 };
+    std::atomic<int> numTasksRemaining { 0 };
+    std::atomic<Job*> currentJob { nullptr };
+
+    JUCE_DECLARE_NON_COPYABLE(WorkerPool)
+};
+}
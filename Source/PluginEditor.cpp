@@ -1,40 +1,47 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-ModalShiftAudioProcessorEditor::ModalShiftAudioProcessorEditor (ModalShiftAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
-{
-    // Make sure that before the constructor has finished, you've set the
-    // editor's size to whatever you need it to be.
-    setSize (400, 300);
-}
-
-ModalShiftAudioProcessorEditor::~ModalShiftAudioProcessorEditor()
-{
-}
-
-//==============================================================================
-void ModalShiftAudioProcessorEditor::paint (juce::Graphics& g)
-{
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::white);
-    g.setFont (juce::FontOptions (15.0f));
-    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
-}
-
-void ModalShiftAudioProcessorEditor::resized()
-{
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+ModalShiftAudioProcessorEditor::ModalShiftAudioProcessorEditor (ModalShiftAudioProcessor& p)
+    : AudioProcessorEditor (&p), audioProcessor (p), parameterEditor (p)
+{
+    addAndMakeVisible (parameterEditor);
+    addAndMakeVisible (qualityLabel);
+
+    timerCallback();
+    startTimerHz (10);
+
+    setSize (parameterEditor.getWidth(), parameterEditor.getHeight() + 24);
+}
+
+ModalShiftAudioProcessorEditor::~ModalShiftAudioProcessorEditor()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void ModalShiftAudioProcessorEditor::paint (juce::Graphics& g)
+{
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
+}
+
+void ModalShiftAudioProcessorEditor::resized()
+{
+    auto bounds = getLocalBounds();
+    qualityLabel.setBounds (bounds.removeFromBottom (24).reduced (8, 0));
+    parameterEditor.setBounds (bounds);
+}
+
+void ModalShiftAudioProcessorEditor::timerCallback()
+{
+    qualityLabel.setText ("Quality: " + audioProcessor.getQualityDescription(), juce::dontSendNotification);
+}
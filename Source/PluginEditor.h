@@ -1,33 +1,40 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-
-//==============================================================================
-/**
-*/
-class ModalShiftAudioProcessorEditor  : public juce::AudioProcessorEditor
-{
-public:
-    ModalShiftAudioProcessorEditor (ModalShiftAudioProcessor&);
-    ~ModalShiftAudioProcessorEditor() override;
-
-    //==============================================================================
-    void paint (juce::Graphics&) override;
-    void resized() override;
-
-private:
-    // This reference is provided as a quick way for your editor to
-    // access the processor object that created it.
-    ModalShiftAudioProcessor& audioProcessor;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModalShiftAudioProcessorEditor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/**
+*/
+class ModalShiftAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                        private juce::Timer
+{
+public:
+    ModalShiftAudioProcessorEditor (ModalShiftAudioProcessor&);
+    ~ModalShiftAudioProcessorEditor() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    // Shows the quality governor's level
+    void timerCallback() override;
+
+    // This reference is provided as a quick way for your editor to
+    // access the processor object that created it.
+    ModalShiftAudioProcessor& audioProcessor;
+
+    juce::GenericAudioProcessorEditor parameterEditor;
+    juce::Label qualityLabel;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModalShiftAudioProcessorEditor)
+};
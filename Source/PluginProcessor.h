@@ -1,96 +1,135 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "DSP/FrequencyShifter.h"
-#include "Params.h"
-#include "MidiProcessor.h"
-
-//==============================================================================
-/**
-*/
-class ModalShiftAudioProcessor  : public juce::AudioProcessor
-{
-public:
-    
-    AudioProcessorValueTreeState apvts;
-//    AudioParameterFloat* myRootptr;
-//    AudioParameterFloat* myResonanceptr;
-//    AudioParameterChoice* mySlopeptr;
-//    AudioParameterBool* myBypassptr;
-    
-//    AudioParameterFloat* myFreqShiftptr;
-    std::vector<param::RAP*> params;
-    
-    
-    
-    //==============================================================================
-    ModalShiftAudioProcessor();
-    ~ModalShiftAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-
-private:
-    
-    // possibility of 4th-order band pass, 32 harmonics
-    
-    std::array<std::array<std::array<juce::dsp::IIR::Filter<float>, MAX_ORDER>, MAX_HARMONICS>, 2> filters;
-    std::array<std::array<std::unique_ptr<xynth::FrequencyShifter>, MAX_HARMONICS>, 2> shifters;
-    
-    dsp::ProcessSpec mySpec;
-    
-    juce::dsp::Oscillator<float> osc;
-    
-    std::array<std::array<std::atomic<float>, MAX_HARMONICS>, 2> shiftAmt{0.0f};
-
-    // Create separate buffers for each filter
-    std::vector<juce::AudioBuffer<float>> filterBuffers;
-
-    const int rootPID = static_cast<int>(param::PID::Root);
-    const int resonancePID = static_cast<int>(param::PID::Resonance);
-    const int numHarmonicsPID = static_cast<int>(param::PID::NumHarmonics);
-    const int filterOrderPID = static_cast<int>(param::PID::FilterOrder);
-
-    MidiProcessor midiProcessor;
-    
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModalShiftAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSP/HarmonicEngine.h"
+#include "DSP/QualityGovernor.h"
+#include "Params.h"
+#include "MidiProcessor.h"
+
+// Worker threads that help render harmonics. 0 keeps all the work on the host's audio thread.
+#ifndef MODALSHIFT_WORKER_THREADS
+ #define MODALSHIFT_WORKER_THREADS 0
+#endif
+
+//==============================================================================
+/**
+*/
+class ModalShiftAudioProcessor  : public juce::AudioProcessor
+{
+public:
+    
+    AudioProcessorValueTreeState apvts;
+//    AudioParameterFloat* myRootptr;
+//    AudioParameterFloat* myResonanceptr;
+//    AudioParameterChoice* mySlopeptr;
+//    AudioParameterBool* myBypassptr;
+    
+//    AudioParameterFloat* myFreqShiftptr;
+    std::vector<param::RAP*> params;
+    
+    
+    
+    //==============================================================================
+    ModalShiftAudioProcessor();
+    ~ModalShiftAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+    //==============================================================================
+    // The engine's stage timings over the last second, for display. Message thread
+    // only, and always empty unless built with MODALSHIFT_PROFILE_STAGES.
+    xynth::StageProfiler::Snapshot getStageProfile() const;
+
+    // How far the quality governor has stepped down, 0 being full quality, and
+    // what that has taken off. Safe to poll from the message thread.
+    int getQualityLevel() const noexcept { return governor.getLevel(); }
+    juce::String getQualityDescription() const { return governor.getDescription(); }
+
+private:
+    
+    // possibility of 4th-order band pass, 32 harmonics
+    
+    xynth::HarmonicEngine engine;
+    xynth::QualityGovernor governor;
+
+   #if MODALSHIFT_PROFILE_STAGES
+    // Takes the engine's stage timings once a second and writes them to the log
+    class StageProfileLogger : private juce::Timer
+    {
+    public:
+        explicit StageProfileLogger (xynth::StageProfiler& p) : profiler (p) { startTimer (1000); }
+        ~StageProfileLogger() override { stopTimer(); }
+
+        xynth::StageProfiler::Snapshot latest;
+
+    private:
+        void timerCallback() override
+        {
+            latest = profiler.collect();
+            if (latest.numBlocks > 0)
+                juce::Logger::writeToLog ("ModalShift stages: " + latest.toString());
+        }
+
+        xynth::StageProfiler& profiler;
+    };
+
+    StageProfileLogger stageProfileLogger { engine.getStageProfiler() };
+   #endif
+    
+    dsp::ProcessSpec mySpec;
+    
+    juce::dsp::Oscillator<float> osc;
+    
+    std::array<std::array<std::atomic<float>, MAX_HARMONICS>, 2> shiftAmt{0.0f};
+
+    const int rootPID = static_cast<int>(param::PID::Root);
+    const int resonancePID = static_cast<int>(param::PID::Resonance);
+    const int numHarmonicsPID = static_cast<int>(param::PID::NumHarmonics);
+    const int filterOrderPID = static_cast<int>(param::PID::FilterOrder);
+    const int enginePID = static_cast<int>(param::PID::Engine);
+    const int governorPID = static_cast<int>(param::PID::Governor);
+
+    MidiProcessor midiProcessor;
+    
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModalShiftAudioProcessor)
+};
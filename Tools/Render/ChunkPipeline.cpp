@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    ChunkPipeline.cpp
+    Created: 19 Oct 2026 10:05:44am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "ChunkPipeline.h"
+
+namespace xynth
+{
+
+ChunkPipeline::ChunkPipeline(int numSlots, int numChannels, int chunkSize)
+{
+    slots.resize(static_cast<size_t>(numSlots));
+    for (auto& slot : slots)
+        slot.setSize(numChannels, chunkSize);
+}
+
+juce::AudioBuffer<float>* ChunkPipeline::waitFor(Step step, juce::int64 chunk)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&] { return cancelled || isReady(step, chunk); });
+
+    if (cancelled)
+        return nullptr;
+
+    return &slots[static_cast<size_t>(chunk % static_cast<juce::int64>(slots.size()))];
+}
+
+void ChunkPipeline::finished(Step step, juce::int64 chunk)
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        numFinished[static_cast<size_t>(step)] = chunk + 1;
+    }
+    changed.notify_all();
+}
+
+void ChunkPipeline::cancel()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        cancelled = true;
+    }
+    changed.notify_all();
+}
+
+bool ChunkPipeline::isCancelled() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    return cancelled;
+}
+
+bool ChunkPipeline::isReady(Step step, juce::int64 chunk) const noexcept
+{
+    const auto done = [this](Step s) { return numFinished[static_cast<size_t>(s)]; };
+
+    switch (step)
+    {
+        // The slot is free once its previous chunk has been written out
+        case Step::Read:    return chunk < done(Step::Write) + static_cast<juce::int64>(slots.size());
+        case Step::Process: return chunk < done(Step::Read);
+        case Step::Write:   return chunk < done(Step::Process);
+        default:            return false;
+    }
+}
+
+} // namespace xynth
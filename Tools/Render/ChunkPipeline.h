@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    ChunkPipeline.h
+    Created: 19 Oct 2026 10:05:44am
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace xynth
+{
+
+// Passes fixed-size audio chunks from a read thread to a render thread to a
+// write thread. Chunk i always lives in slot i % numSlots, and reading waits
+// for a slot to be written out before reusing it, so memory use is the same
+// however long the file is.
+class ChunkPipeline
+{
+public:
+    enum class Step { Read, Process, Write, NumSteps };
+
+public:
+    ChunkPipeline(int numSlots, int numChannels, int chunkSize);
+
+    // Blocks until the step can run on this chunk and returns its slot, or
+    // nullptr if the pipeline was cancelled. Each step takes chunks in order.
+    juce::AudioBuffer<float>* waitFor(Step step, juce::int64 chunk);
+    void finished(Step step, juce::int64 chunk);
+
+    // Wakes every waiting step with nullptr, e.g. after a read or write error
+    void cancel();
+    bool isCancelled() const;
+
+private:
+    bool isReady(Step step, juce::int64 chunk) const noexcept;
+
+    std::vector<juce::AudioBuffer<float>> slots;
+    std::array<juce::int64, static_cast<size_t>(Step::NumSteps)> numFinished {};
+    bool cancelled = false;
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+
+};
+}
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+    FileRenderer.cpp
+    Created: 18 Oct 2026 4:32:18pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "FileRenderer.h"
+#include "ChunkPipeline.h"
+
+#include <thread>
+
+namespace xynth
+{
+
+FileRenderer::FileRenderer(const RenderSettings& s, const Options& o)
+    : settings(s), options(o)
+{
+    formatManager.registerBasicFormats();
+    engine.setTracer(options.tracer);
+}
+
+juce::Result FileRenderer::render(const juce::File& input, const juce::File& output, Stats& stats)
+{
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(input));
+    if (reader == nullptr)
+        return juce::Result::fail("can't read " + input.getFullPathName());
+
+    const auto numChannels = static_cast<int>(reader->numChannels);
+    const auto length = reader->lengthInSamples;
+
+    output.getParentDirectory().createDirectory();
+    output.deleteFile();
+
+    auto stream = output.createOutputStream();
+    if (stream == nullptr)
+        return juce::Result::fail("can't write " + output.getFullPathName());
+
+    // Switches to RF64 by itself once the output passes 4 GB
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), reader->sampleRate,
+                                                                              static_cast<unsigned int>(numChannels),
+                                                                              options.bitsPerSample, {}, 0));
+    if (writer == nullptr)
+        return juce::Result::fail("can't write " + output.getFullPathName());
+
+    // The writer owns the stream now
+    stream.release();
+
+    prepare(reader->sampleRate, numChannels);
+
+    const auto chunkSize = static_cast<juce::int64>(options.chunkSize);
+    const auto numChunks = (length + chunkSize - 1) / chunkSize;
+    const auto getChunkLength = [&](juce::int64 chunk) { return static_cast<int>(juce::jmin(chunkSize, length - chunk * chunkSize)); };
+
+    using Step = ChunkPipeline::Step;
+    ChunkPipeline pipeline(options.numChunksInFlight, numChannels, options.chunkSize);
+    // Each I/O thread only ever writes its own
+    juce::String readError, writeError;
+
+    std::thread readThread([&]
+    {
+        for (juce::int64 chunk = 0; chunk < numChunks; ++chunk)
+        {
+            auto* slot = pipeline.waitFor(Step::Read, chunk);
+            if (slot == nullptr)
+                return;
+
+            if (! reader->read(slot, 0, getChunkLength(chunk), chunk * chunkSize, true, true))
+            {
+                readError = "error reading " + input.getFullPathName();
+                pipeline.cancel();
+                return;
+            }
+            pipeline.finished(Step::Read, chunk);
+        }
+    });
+
+    std::thread writeThread([&]
+    {
+        for (juce::int64 chunk = 0; chunk < numChunks; ++chunk)
+        {
+            auto* slot = pipeline.waitFor(Step::Write, chunk);
+            if (slot == nullptr)
+                return;
+
+            if (! writer->writeFromAudioSampleBuffer(*slot, 0, getChunkLength(chunk)))
+            {
+                writeError = "error writing " + output.getFullPathName();
+                pipeline.cancel();
+                return;
+            }
+            pipeline.finished(Step::Write, chunk);
+        }
+    });
+
+    // Like the plugin's processBlock. The flags are per thread, so they go on the one
+    // the engine runs on rather than in main().
+    juce::ScopedNoDenormals noDenormals;
+
+    for (juce::int64 chunk = 0; chunk < numChunks; ++chunk)
+    {
+        auto* slot = pipeline.waitFor(Step::Process, chunk);
+        if (slot == nullptr)
+            break;
+
+        processChunk(*slot, getChunkLength(chunk));
+        pipeline.finished(Step::Process, chunk);
+    }
+
+    readThread.join();
+    writeThread.join();
+
+    if (pipeline.isCancelled())
+        return juce::Result::fail(readError.isNotEmpty() ? readError : writeError);
+
+    // Finalises the header
+    writer.reset();
+
+    stats.audioSeconds += static_cast<double>(length) / reader->sampleRate;
+    stats.wallSeconds += (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+    return juce::Result::ok();
+}
+
+void FileRenderer::processChunk(juce::AudioBuffer<float>& chunk, int numSamples) noexcept
+{
+    // Still the block size a host would use, so the engine sees what it sees in the plugin
+    juce::dsp::AudioBlock<float> chunkBlock(chunk);
+    for (int start = 0; start < numSamples; start += options.blockSize)
+    {
+        const auto blockLength = juce::jmin(options.blockSize, numSamples - start);
+        auto block = chunkBlock.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(blockLength));
+        processBlock(block);
+    }
+}
+
+void FileRenderer::prepare(double sampleRate, int numChannels)
+{
+    const auto unchanged = spec.sampleRate == sampleRate
+                        && spec.numChannels == static_cast<juce::uint32>(numChannels)
+                        && spec.maximumBlockSize == static_cast<juce::uint32>(options.blockSize);
+
+    spec = { sampleRate, static_cast<juce::uint32>(options.blockSize), static_cast<juce::uint32>(numChannels) };
+
+    if (unchanged)
+    {
+        engine.reset();
+        return;
+    }
+
+    engine.prepare(spec, MAX_HARMONICS);
+    engine.setNumWorkerThreads(options.engineThreads);
+}
+
+void FileRenderer::processBlock(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    // Mirrors ModalShiftAudioProcessor::processBlock, with the MIDI-driven shift fixed.
+    // There's no deadline offline, so the governor parameter is ignored and every
+    // file renders at full quality.
+    const auto rootFreq = settings.getValue(param::PID::Root);
+    const auto resonance = settings.getValue(param::PID::Resonance);
+    const auto numHarmonics = settings.getValue(param::PID::NumHarmonics);
+    const auto filterOrder = settings.getValue(param::PID::FilterOrder);
+    const auto engineMode = settings.getValue(param::PID::Engine);
+
+    const auto numStages = static_cast<int>(filterOrder);
+    const auto effectiveHarmonics = engine.getNumHarmonicsBelowNyquist(rootFreq, static_cast<int>(numHarmonics));
+
+    for (int harmonic = 0; harmonic < effectiveHarmonics; ++harmonic)
+        engine.setShiftFrequency(harmonic, settings.getShift());
+
+    engine.setMode(static_cast<HarmonicEngine::Mode>(static_cast<int>(engineMode)));
+
+    engine.process(block, rootFreq, resonance, effectiveHarmonics, numStages);
+}
+
+} // namespace xynth
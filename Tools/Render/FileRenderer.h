@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    FileRenderer.h
+    Created: 18 Oct 2026 4:32:18pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSP/HarmonicEngine.h"
+#include "RenderSettings.h"
+
+namespace xynth
+{
+
+// Renders audio files through its own HarmonicEngine, driven the same way
+// ModalShiftAudioProcessor::processBlock drives it. One per render job.
+//
+// Files are streamed: a read thread, the calling thread and a write thread
+// pass fixed-size chunks through a ChunkPipeline, so memory use stays the same
+// for a multi-hour recording as for a short one.
+class FileRenderer
+{
+public:
+    struct Options
+    {
+        // Samples per engine call
+        int blockSize = 4096;
+        // Samples per read and write, and how many chunks can be in flight
+        int chunkSize = 1 << 16;
+        int numChunksInFlight = 4;
+        int bitsPerSample = 24;
+        // Worker threads inside the engine; files already run in parallel, so usually 0
+        int engineThreads = 0;
+        // Where to record engine calls, if anywhere; can be shared between renderers
+        BlockTracer* tracer = nullptr;
+    };
+
+    struct Stats
+    {
+        double audioSeconds = 0.0, wallSeconds = 0.0;
+        double getRealtimeFactor() const noexcept { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+    };
+
+public:
+    FileRenderer(const RenderSettings& settings, const Options& options);
+
+    // Renders input to a WAV file at output, replacing it
+    juce::Result render(const juce::File& input, const juce::File& output, Stats& stats);
+
+private:
+    void prepare(double sampleRate, int numChannels);
+    void processBlock(juce::dsp::AudioBlock<float>& block) noexcept;
+    void processChunk(juce::AudioBuffer<float>& chunk, int numSamples) noexcept;
+
+    const RenderSettings& settings;
+    const Options options;
+
+    juce::AudioFormatManager formatManager;
+    HarmonicEngine engine;
+    juce::dsp::ProcessSpec spec { 0.0, 0, 0 };
+
+};
+}
@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 4:32:18pm
+    Author:  q
+
+    Offline renderer: runs audio files through the ModalShift engine faster
+    than real time, several files at once. Files are streamed in chunks, so
+    memory use doesn't grow with their length.
+
+      ModalShiftRender [options] input.wav [more inputs...]
+
+      --preset file.json     parameter values as a JSON object
+      --set id=value         one parameter, e.g. --set root=A2 --set engine=Resonator
+      --out-dir dir          where to write (default: next to each input)
+      --jobs n               files rendered at once (default: number of cores)
+      --block n              samples per process call (default 4096)
+      --chunk n              samples per read and write (default 65536)
+      --bits n               output bit depth (default 24)
+      --trace file.json      record every engine call as a Chrome trace
+
+    Parameter IDs are the plugin's: root, resonance, numofharmonics2,
+    filterorder, engine, plus "shift" for the frequency shift in Hz. Older
+    IDs, like numofharmonics, still work.
+    Outputs are written as <name>.modalshift.wav.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FileRenderer.h"
+#include "RenderSettings.h"
+
+#include <iostream>
+
+namespace
+{
+
+struct CommandLine
+{
+    juce::Array<juce::File> inputs;
+    juce::File outputDirectory, traceFile;
+    xynth::FileRenderer::Options renderOptions;
+    int numJobs = juce::SystemStats::getNumCpus();
+};
+
+juce::Result parseCommandLine(const juce::StringArray& args, CommandLine& commandLine, xynth::RenderSettings& settings)
+{
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const auto& arg = args[i];
+
+        if (! arg.startsWith("--"))
+        {
+            commandLine.inputs.add(cwd.getChildFile(arg));
+            continue;
+        }
+
+        if (i + 1 >= args.size())
+            return juce::Result::fail("missing value for " + arg);
+
+        const auto value = args[++i];
+
+        if (arg == "--preset")
+        {
+            const auto result = settings.loadPreset(cwd.getChildFile(value));
+            if (result.failed())
+                return result;
+        }
+        else if (arg == "--set")
+        {
+            if (! value.containsChar('='))
+                return juce::Result::fail("expected id=value, got " + value);
+
+            const auto result = settings.set(value.upToFirstOccurrenceOf("=", false, false),
+                                             value.fromFirstOccurrenceOf("=", false, false));
+            if (result.failed())
+                return result;
+        }
+        else if (arg == "--out-dir")    commandLine.outputDirectory = cwd.getChildFile(value);
+        else if (arg == "--jobs")       commandLine.numJobs = juce::jmax(1, value.getIntValue());
+        else if (arg == "--block")      commandLine.renderOptions.blockSize = juce::jmax(1, value.getIntValue());
+        else if (arg == "--chunk")      commandLine.renderOptions.chunkSize = juce::jmax(1, value.getIntValue());
+        else if (arg == "--bits")       commandLine.renderOptions.bitsPerSample = value.getIntValue();
+        else if (arg == "--trace")      commandLine.traceFile = cwd.getChildFile(value);
+        else                            return juce::Result::fail("unknown option " + arg);
+    }
+
+    if (commandLine.inputs.isEmpty())
+        return juce::Result::fail("no input files");
+
+    return juce::Result::ok();
+}
+
+bool writeTrace(const xynth::BlockTracer& tracer, const juce::File& file)
+{
+    file.deleteFile();
+    juce::FileOutputStream stream(file);
+    if (stream.failedToOpen())
+    {
+        std::cerr << "error: could not write " << file.getFullPathName() << std::endl;
+        return false;
+    }
+
+    tracer.write(stream);
+    std::cout << "trace of " << tracer.getNumBlocksRecorded() << " blocks written to " << file.getFullPathName()
+              << (tracer.hasWrapped() ? " (only the most recent events fit)" : "") << std::endl;
+    return true;
+}
+
+juce::File getOutputFile(const juce::File& input, const juce::File& outputDirectory)
+{
+    const auto directory = outputDirectory == juce::File() ? input.getParentDirectory() : outputDirectory;
+    return directory.getChildFile(input.getFileNameWithoutExtension() + ".modalshift.wav");
+}
+
+// Each job owns a renderer, and with it an engine, and takes files until none are left
+class RenderJob : public juce::Thread
+{
+public:
+    RenderJob(const CommandLine& c, const xynth::RenderSettings& settings,
+              std::atomic<int>& next, juce::CriticalSection& lock)
+        : juce::Thread("ModalShift render"), commandLine(c), renderer(settings, c.renderOptions),
+          nextInput(next), logLock(lock)
+    {
+    }
+
+    void run() override
+    {
+        for (;;)
+        {
+            const auto index = nextInput.fetch_add(1);
+            if (index >= commandLine.inputs.size() || threadShouldExit())
+                return;
+
+            const auto& input = commandLine.inputs.getReference(index);
+            const auto output = getOutputFile(input, commandLine.outputDirectory);
+
+            xynth::FileRenderer::Stats fileStats;
+            const auto result = renderer.render(input, output, fileStats);
+
+            const juce::ScopedLock sl(logLock);
+            if (result.failed())
+            {
+                ++numFailed;
+                std::cerr << "error: " << result.getErrorMessage() << std::endl;
+                continue;
+            }
+
+            stats.audioSeconds += fileStats.audioSeconds;
+            stats.wallSeconds += fileStats.wallSeconds;
+            std::cout << output.getFullPathName() << ": " << juce::String(fileStats.audioSeconds, 1) << " s audio, "
+                      << juce::String(fileStats.getRealtimeFactor(), 1) << "x real time" << std::endl;
+        }
+    }
+
+    xynth::FileRenderer::Stats stats;
+    int numFailed = 0;
+
+private:
+    const CommandLine& commandLine;
+    xynth::FileRenderer renderer;
+    std::atomic<int>& nextInput;
+    juce::CriticalSection& logLock;
+};
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::String::fromUTF8(argv[i]));
+
+    CommandLine commandLine;
+    xynth::RenderSettings settings;
+
+    const auto parsed = parseCommandLine(args, commandLine, settings);
+    if (parsed.failed())
+    {
+        std::cerr << "error: " << parsed.getErrorMessage() << "\n"
+                  << "usage: ModalShiftRender [--preset file.json] [--set id=value ...] [--out-dir dir]\n"
+                  << "                        [--jobs n] [--block n] [--chunk n] [--bits n] [--trace file.json]\n"
+                  << "                        input.wav ..." << std::endl;
+        return 1;
+    }
+
+    std::cout << settings.toString() << std::endl;
+
+    std::unique_ptr<xynth::BlockTracer> tracer;
+    if (commandLine.traceFile != juce::File())
+    {
+        tracer = std::make_unique<xynth::BlockTracer>();
+        commandLine.renderOptions.tracer = tracer.get();
+    }
+
+    const auto numJobs = juce::jmin(commandLine.numJobs, commandLine.inputs.size());
+    std::atomic<int> nextInput { 0 };
+    juce::CriticalSection logLock;
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    std::vector<std::unique_ptr<RenderJob>> jobs;
+    for (int i = 0; i < numJobs; ++i)
+    {
+        jobs.push_back(std::make_unique<RenderJob>(commandLine, settings, nextInput, logLock));
+        jobs.back()->startThread();
+    }
+
+    double audioSeconds = 0.0;
+    int numFailed = 0;
+    for (auto& job : jobs)
+    {
+        job->waitForThreadToExit(-1);
+        audioSeconds += job->stats.audioSeconds;
+        numFailed += job->numFailed;
+    }
+
+    const auto wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+    std::cout << "rendered " << juce::String(audioSeconds, 1) << " s of audio in " << juce::String(wallSeconds, 2)
+              << " s with " << numJobs << " jobs: " << juce::String(audioSeconds / juce::jmax(wallSeconds, 1.0e-9), 1)
+              << "x real time" << std::endl;
+
+    if (tracer != nullptr && ! writeTrace(*tracer, commandLine.traceFile))
+        return 1;
+
+    return numFailed == 0 ? 0 : 1;
+}
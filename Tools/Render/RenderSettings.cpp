@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    RenderSettings.cpp
+    Created: 18 Oct 2026 4:32:18pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "RenderSettings.h"
+
+namespace xynth
+{
+
+RenderSettings::RenderSettings()
+    : parameters(param::createParameters())
+{
+}
+
+juce::Result RenderSettings::set(const juce::String& nameOrID, const juce::String& value)
+{
+    const auto text = value.trim();
+
+    if (nameOrID.equalsIgnoreCase("shift"))
+    {
+        shift = text.getFloatValue();
+        return juce::Result::ok();
+    }
+
+    auto* parameter = find(nameOrID);
+    if (parameter == nullptr)
+        return juce::Result::fail("unknown parameter: " + nameOrID);
+
+    if (text.isEmpty())
+        return juce::Result::fail("no value for " + nameOrID);
+
+    // Numbers are taken in the parameter's own units, anything else goes through its text parser
+    const auto isNumber = juce::String("0123456789.-+").containsChar(text[0]) && text.containsOnly("0123456789.-+eE");
+
+    float normalised;
+    if (isNumber)
+    {
+        normalised = parameter->convertTo0to1(text.getFloatValue());
+    }
+    else
+    {
+        try
+        {
+            normalised = parameter->getValueForText(text);
+        }
+        catch (const std::exception&)
+        {
+            return juce::Result::fail("invalid value for " + nameOrID + ": " + value);
+        }
+    }
+
+    parameter->setValue(juce::jlimit(0.f, 1.f, normalised));
+    return juce::Result::ok();
+}
+
+juce::Result RenderSettings::loadPreset(const juce::File& file)
+{
+    if (! file.existsAsFile())
+        return juce::Result::fail("preset not found: " + file.getFullPathName());
+
+    juce::var preset;
+    const auto parsed = juce::JSON::parse(file.loadFileAsString(), preset);
+    if (parsed.failed())
+        return juce::Result::fail(file.getFileName() + ": " + parsed.getErrorMessage());
+
+    auto* object = preset.getDynamicObject();
+    if (object == nullptr)
+        return juce::Result::fail(file.getFileName() + ": expected a JSON object");
+
+    for (const auto& property : object->getProperties())
+    {
+        const auto result = set(property.name.toString(), property.value.toString());
+        if (result.failed())
+            return result;
+    }
+
+    return juce::Result::ok();
+}
+
+float RenderSettings::getValue(param::PID pID) const
+{
+    auto* parameter = find(param::toID(pID).getParamID());
+    jassert(parameter != nullptr);
+    return parameter->getNormalisableRange().convertFrom0to1(parameter->getValue());
+}
+
+juce::String RenderSettings::toString() const
+{
+    juce::StringArray items;
+    for (const auto& parameter : parameters)
+        items.add(parameter->getName(64) + ": " + parameter->getCurrentValueAsText());
+    items.add("Shift: " + juce::String(shift, 2) + " Hz");
+    return items.joinIntoString(", ");
+}
+
+param::RAP* RenderSettings::find(const juce::String& nameOrID) const
+{
+    // IDs from before a parameter's range changed still work
+    const auto id = param::toCurrentID(nameOrID);
+
+    for (const auto& parameter : parameters)
+        if (parameter->getParameterID().equalsIgnoreCase(id) || parameter->getName(64).equalsIgnoreCase(nameOrID))
+            return parameter.get();
+    return nullptr;
+}
+
+} // namespace xynth
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    RenderSettings.h
+    Created: 18 Oct 2026 4:32:18pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Params.h"
+
+namespace xynth
+{
+
+// The plugin's parameters for an offline render. They come from
+// param::createParameters(), so ranges, defaults and text parsing are the
+// plugin's own, and are read back the way processBlock reads them.
+class RenderSettings
+{
+public:
+    RenderSettings();
+
+    // Sets a parameter by ID ("numofharmonics2", or an older one) or name ("Num of Harmonics").
+    // The value is either a plain number in the parameter's units or any text
+    // the parameter understands, e.g. "A2" for Root or "Resonator" for Engine.
+    // "shift" sets the frequency shift in Hz for every harmonic.
+    juce::Result set(const juce::String& nameOrID, const juce::String& value);
+
+    // Applies every property of a JSON object, e.g. {"root": "A2", "resonance": 5}
+    juce::Result loadPreset(const juce::File& file);
+
+    // The denormalised value, as processBlock sees it
+    float getValue(param::PID pID) const;
+    float getShift() const noexcept { return shift; }
+
+    juce::String toString() const;
+
+private:
+    param::RAP* find(const juce::String& nameOrID) const;
+
+    param::UniqueRAPVector parameters;
+    // processBlock takes this from MidiProcessor; offline it is one fixed value
+    float shift = 0.f;
+
+};
+}
@@ -0,0 +1,618 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 1:47:03pm
+    Author:  q
+
+    Golden-output checks: renders fixed stimuli through the optimised DSP
+    and through frozen scalar copies of the original code, and compares.
+
+      ModalShiftValidate [--verbose]
+
+    Checks:
+      hilbert    HilbertProcessor against Signalsmith's HilbertIIR
+      biquad     BiquadBank against juce::dsp::IIR::Filter cascades
+      engine     HarmonicEngine against reference::Engine, in the modes
+                 that are meant to sound the same, by worst sample error
+                 and by spectral error
+      threads    HarmonicEngine with and without workers, bit for bit
+      idle       HarmonicEngine going idle between two impulses further
+                 apart than its tail, against the same engine never idling
+      reset      HarmonicEngine reset after idling through a silent file,
+                 against a freshly prepared one, bit for bit
+      governor   QualityGovernor stepping down at small block sizes: the
+                 gain never rises during a fade out, and never jumps by more
+                 than one step of the fade
+      mix        HarmonicEngine's per-harmonic gain and pan: halving every
+                 gain against half the output, muting the upper harmonics
+                 against rendering fewer, and panning hard to either side
+                 against the two channels summed
+      isa        HarmonicEngine against reference::Engine with every set of
+                 SIMDKernels this CPU runs
+
+    --isa runs everything else with the named set (generic, sse2, avx2,
+    avx512 or neon) rather than the best one. If this build or CPU can't run
+    it, nothing runs and the exit code is 77, which CTest counts as skipped.
+
+    Errors are in dB relative to the reference (its peak for sample errors,
+    its magnitude spectrum for spectral ones). Prints one line per check
+    and exits non-zero if any fail.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DSP/HarmonicEngine.h"
+#include "DSP/QualityGovernor.h"
+#include "ReferenceEngine.h"
+#include "Stimuli.h"
+
+#include <iostream>
+
+namespace
+{
+
+using xynth::HarmonicEngine;
+
+constexpr int numChannels = 2;
+constexpr float rootFrequency = 110.f;
+constexpr float resonance = 10.f;
+
+// Uneven on purpose, so that tiles, chunks and SIMD remainders all get exercised
+constexpr int blockSizes[] = { 512, 37, 1024, 1, 256, 300 };
+constexpr int maxBlockSize = 1024;
+
+// Worst sample error and spectral error allowed, in dB. The engine keeps its
+// oscillators in float and sums the harmonics before anti-aliasing, so it
+// lands around -70 dB against the reference at worst, not bit exact.
+constexpr double oracleTolerance = -100.0;
+// Kernels with FMA round the biquad recursion differently from juce::dsp::IIR,
+// and a high-Q cascade amplifies that
+constexpr double fusedOracleTolerance = -70.0;
+constexpr double engineTolerance = -60.0;
+constexpr double spectralTolerance = -70.0;
+
+// SKIP_RETURN_CODE of the --isa tests in Tools/CMakeLists.txt
+constexpr int skippedExitCode = 77;
+
+double toDecibels(double error, double reference)
+{
+    if (error == 0.0)
+        return -std::numeric_limits<double>::infinity();
+
+    return 20.0 * std::log10(error / juce::jmax(reference, 1.0e-30));
+}
+
+struct Report
+{
+    int numPassed = 0, numFailed = 0;
+    bool verbose = false;
+
+    void check(const juce::String& name, bool passed, const juce::String& details)
+    {
+        ++(passed ? numPassed : numFailed);
+        if (passed && ! verbose)
+            return;
+
+        std::cout << (passed ? "PASS  " : "FAIL  ") << name.paddedRight(' ', 64) << details << std::endl;
+    }
+};
+
+// Worst sample error in dB below the reference peak
+double getMaxError(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& test)
+{
+    double maxError = 0.0, peak = 0.0;
+    for (int channel = 0; channel < reference.getNumChannels(); ++channel)
+    {
+        const auto* r = reference.getReadPointer(channel);
+        const auto* t = test.getReadPointer(channel);
+        for (int i = 0; i < reference.getNumSamples(); ++i)
+        {
+            maxError = juce::jmax(maxError, static_cast<double>(std::abs(r[i] - t[i])));
+            peak = juce::jmax(peak, static_cast<double>(std::abs(r[i])));
+        }
+    }
+
+    return toDecibels(maxError, peak);
+}
+
+// Distance between the magnitude spectra of Hann-windowed frames, in dB
+// relative to the reference spectrum. Insensitive to tiny phase differences
+// that a sample-by-sample comparison would count as errors.
+double getSpectralError(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& test)
+{
+    constexpr int fftOrder = 11;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int hopSize = fftSize / 2;
+
+    juce::dsp::FFT fft(fftOrder);
+    std::vector<float> window(fftSize), referenceFrame(2 * fftSize), testFrame(2 * fftSize);
+    for (int i = 0; i < fftSize; ++i)
+        window[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * i / fftSize);
+
+    double errorEnergy = 0.0, referenceEnergy = 0.0;
+    for (int channel = 0; channel < reference.getNumChannels(); ++channel)
+    {
+        for (int start = 0; start + fftSize <= reference.getNumSamples(); start += hopSize)
+        {
+            std::fill(referenceFrame.begin(), referenceFrame.end(), 0.f);
+            std::fill(testFrame.begin(), testFrame.end(), 0.f);
+            for (int i = 0; i < fftSize; ++i)
+            {
+                referenceFrame[static_cast<size_t>(i)] = reference.getSample(channel, start + i) * window[static_cast<size_t>(i)];
+                testFrame[static_cast<size_t>(i)] = test.getSample(channel, start + i) * window[static_cast<size_t>(i)];
+            }
+
+            fft.performFrequencyOnlyForwardTransform(referenceFrame.data());
+            fft.performFrequencyOnlyForwardTransform(testFrame.data());
+
+            for (size_t bin = 0; bin <= fftSize / 2; ++bin)
+            {
+                const auto difference = static_cast<double>(referenceFrame[bin] - testFrame[bin]);
+                errorEnergy += difference * difference;
+                referenceEnergy += static_cast<double>(referenceFrame[bin]) * referenceFrame[bin];
+            }
+        }
+    }
+
+    return toDecibels(std::sqrt(errorEnergy), std::sqrt(referenceEnergy));
+}
+
+juce::String describe(double sampleRate, int numHarmonics, int numStages)
+{
+    return "H=" + juce::String(numHarmonics) + " order=" + juce::String(numStages)
+         + " " + juce::String(juce::roundToInt(sampleRate / 1000.0)) + "k";
+}
+
+juce::String formatDecibels(double decibels)
+{
+    return std::isinf(decibels) ? juce::String("exact") : juce::String(decibels, 1) + " dB";
+}
+
+//==============================================================================
+// Runs a stimulus through process(block, startSample) in uneven blocks
+template <typename ProcessFunction>
+juce::AudioBuffer<float> renderInBlocks(const xynth::Stimulus& stimulus, ProcessFunction&& process)
+{
+    auto output = stimulus.audio;
+    const auto numSamples = output.getNumSamples();
+
+    for (int start = 0, i = 0; start < numSamples; ++i)
+    {
+        const auto blockSize = juce::jmin(blockSizes[static_cast<size_t>(i) % std::size(blockSizes)], numSamples - start);
+        juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), output.getNumChannels(), start, blockSize);
+        process(block, start);
+        start += blockSize;
+    }
+
+    return output;
+}
+
+juce::AudioBuffer<float> renderReference(const xynth::Stimulus& stimulus, double sampleRate, int numHarmonics, int numStages)
+{
+    xynth::reference::Engine engine;
+    engine.prepare({ sampleRate, static_cast<juce::uint32>(maxBlockSize), static_cast<juce::uint32>(numChannels) }, numHarmonics);
+
+    return renderInBlocks(stimulus, [&](juce::AudioBuffer<float>& block, int start)
+    {
+        for (int h = 0; h < numHarmonics; ++h)
+            engine.setShiftFrequency(h, stimulus.getShift(h, start, rootFrequency));
+
+        engine.process(block, rootFrequency, resonance, numHarmonics, numStages);
+    });
+}
+
+// wentIdle, if given, turns idling on (as the plugin runs) and is set if the
+// engine was idle after any block. Otherwise every block is processed, so
+// that long stimuli compare sample for sample. setUp, if given, is called on
+// the engine once it's prepared.
+juce::AudioBuffer<float> renderEngine(const xynth::Stimulus& stimulus, double sampleRate, int numHarmonics, int numStages,
+                                      HarmonicEngine::Mode mode, int numWorkerThreads, bool* wentIdle = nullptr,
+                                      const std::function<void (HarmonicEngine&)>& setUp = nullptr)
+{
+    HarmonicEngine engine;
+    engine.prepare({ sampleRate, static_cast<juce::uint32>(maxBlockSize), static_cast<juce::uint32>(numChannels) }, numHarmonics);
+    engine.setMode(mode);
+    engine.setNumWorkerThreads(numWorkerThreads);
+    engine.setIdleWhenSilent(wentIdle != nullptr);
+    if (setUp != nullptr)
+        setUp(engine);
+
+    return renderInBlocks(stimulus, [&](juce::AudioBuffer<float>& buffer, int start)
+    {
+        for (int h = 0; h < numHarmonics; ++h)
+            engine.setShiftFrequency(h, stimulus.getShift(h, start, rootFrequency));
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        engine.process(block, rootFrequency, resonance, numHarmonics, numStages);
+
+        if (wentIdle != nullptr && engine.isIdle())
+            *wentIdle = true;
+    });
+}
+
+//==============================================================================
+void checkHilbert(Report& report, const std::vector<xynth::Stimulus>& stimuli, double sampleRate)
+{
+    using Complex = xynth::HilbertProcessor::Complex;
+
+    for (const auto& stimulus : stimuli)
+    {
+        const auto numSamples = stimulus.audio.getNumSamples();
+        const auto* input = stimulus.audio.getReadPointer(0);
+
+        signalsmith::hilbert::HilbertIIR<float> oracle(static_cast<float>(sampleRate), 1);
+        xynth::HilbertProcessor perSample, perBlock;
+        perSample.prepare({ sampleRate, static_cast<juce::uint32>(maxBlockSize), 1 });
+        perBlock.prepare({ sampleRate, static_cast<juce::uint32>(maxBlockSize), 1 });
+        xynth::reference::Hilbert reference;
+        reference.prepare(sampleRate, 1);
+
+        std::vector<Complex> expected(static_cast<size_t>(numSamples)), blockOutput(static_cast<size_t>(numSamples));
+        for (int i = 0; i < numSamples; ++i)
+            expected[static_cast<size_t>(i)] = oracle(input[i]);
+
+        for (int start = 0, b = 0; start < numSamples; ++b)
+        {
+            const auto blockSize = juce::jmin(blockSizes[static_cast<size_t>(b) % std::size(blockSizes)], numSamples - start);
+            perBlock.processBlock(input + start, blockOutput.data() + start, blockSize, 0);
+            start += blockSize;
+        }
+
+        double peak = 0.0, sampleError = 0.0, blockError = 0.0, referenceError = 0.0;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto e = expected[static_cast<size_t>(i)];
+            peak = juce::jmax(peak, static_cast<double>(std::abs(e)));
+            sampleError = juce::jmax(sampleError, static_cast<double>(std::abs(perSample.processSample(input[i], 0) - e)));
+            blockError = juce::jmax(blockError, static_cast<double>(std::abs(blockOutput[static_cast<size_t>(i)] - e)));
+            referenceError = juce::jmax(referenceError, static_cast<double>(std::abs(reference.processSample(Complex(input[i]), 0) - e)));
+        }
+
+        const auto sampleDecibels = toDecibels(sampleError, peak);
+        const auto blockDecibels = toDecibels(blockError, peak);
+        const auto referenceDecibels = toDecibels(referenceError, peak);
+
+        report.check("hilbert/processSample/" + stimulus.name, sampleDecibels <= oracleTolerance, formatDecibels(sampleDecibels));
+        report.check("hilbert/processBlock/" + stimulus.name, blockDecibels <= oracleTolerance, formatDecibels(blockDecibels));
+        report.check("hilbert/reference/" + stimulus.name, referenceDecibels <= oracleTolerance, formatDecibels(referenceDecibels));
+    }
+}
+
+void checkBiquadBank(Report& report, const xynth::Stimulus& stimulus, double sampleRate, int numHarmonics, int numStages)
+{
+    const auto numSamples = stimulus.audio.getNumSamples();
+
+    xynth::BandpassCoefficients coefficients;
+    coefficients.prepare(numHarmonics, sampleRate);
+    xynth::StateArena arena;
+    xynth::BiquadBank bank;
+    bank.prepare(numHarmonics, 1, arena);
+    arena.allocate();
+
+    juce::AudioBuffer<float> bankOutput(numHarmonics, numSamples), expected(numHarmonics, numSamples);
+
+    for (int h = 0; h < numHarmonics; ++h)
+    {
+        const auto frequency = rootFrequency * static_cast<float>(h + 1);
+        coefficients.setBandPass(h, frequency, resonance);
+        bank.setCoefficients(h, coefficients.getRawCoefficients(h));
+
+        const auto juceCoefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, frequency, resonance);
+        std::array<juce::dsp::IIR::Filter<float>, xynth::BiquadBank::maxStages> cascade;
+        for (auto& filter : cascade)
+            filter.coefficients = juceCoefficients;
+
+        const auto* input = stimulus.audio.getReadPointer(0);
+        auto* output = expected.getWritePointer(h);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto sample = input[i];
+            for (int stage = 0; stage < numStages; ++stage)
+                sample = cascade[static_cast<size_t>(stage)].processSample(sample);
+            output[i] = sample;
+        }
+    }
+
+    for (int start = 0, b = 0; start < numSamples; ++b)
+    {
+        const auto blockSize = juce::jmin(blockSizes[static_cast<size_t>(b) % std::size(blockSizes)], numSamples - start);
+        juce::AudioBuffer<float> block(bankOutput.getArrayOfWritePointers(), numHarmonics, start, blockSize);
+        bank.process(stimulus.audio.getReadPointer(0, start), block.getArrayOfWritePointers(), blockSize,
+                     0, 0, numHarmonics, numStages);
+        start += blockSize;
+    }
+
+    const auto decibels = getMaxError(expected, bankOutput);
+    const auto tolerance = xynth::SIMDKernels::get().fused ? fusedOracleTolerance : oracleTolerance;
+    report.check("biquad/" + stimulus.name + " " + describe(sampleRate, numHarmonics, numStages),
+                 decibels <= tolerance, formatDecibels(decibels));
+}
+
+void checkEngine(Report& report, const std::vector<xynth::Stimulus>& stimuli, double sampleRate, int numHarmonics, int numStages)
+{
+    const std::pair<HarmonicEngine::Mode, const char*> modes[] {
+        { HarmonicEngine::Mode::PerHarmonicHilbert, "bandpass" },
+        { HarmonicEngine::Mode::SharedAnalytic, "shared analytic" },
+        { HarmonicEngine::Mode::ComplexResonator, "resonator" }
+    };
+
+    for (const auto& stimulus : stimuli)
+    {
+        const auto reference = renderReference(stimulus, sampleRate, numHarmonics, numStages);
+
+        for (const auto& [mode, modeName] : modes)
+        {
+            const auto name = juce::String(modeName) + "/" + stimulus.name + " " + describe(sampleRate, numHarmonics, numStages);
+            const auto output = renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 0);
+
+            // The resonators are a different filter, so only their determinism is checked
+            if (mode != HarmonicEngine::Mode::ComplexResonator)
+            {
+                const auto maxError = getMaxError(reference, output);
+                const auto spectralError = getSpectralError(reference, output);
+                report.check("engine/" + name, maxError <= engineTolerance && spectralError <= spectralTolerance,
+                             "max " + formatDecibels(maxError) + ", spectral " + formatDecibels(spectralError));
+            }
+
+            const auto threaded = renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 3);
+            const auto threadError = getMaxError(output, threaded);
+            report.check("threads/" + name, std::isinf(threadError), formatDecibels(threadError));
+        }
+    }
+}
+
+void checkIdle(Report& report, double sampleRate)
+{
+    constexpr int numHarmonics = 24, numStages = 2;
+    constexpr auto mode = HarmonicEngine::Mode::PerHarmonicHilbert;
+
+    HarmonicEngine engine;
+    engine.prepare({ sampleRate, static_cast<juce::uint32>(maxBlockSize), static_cast<juce::uint32>(numChannels) }, numHarmonics);
+    const auto tailSamples = static_cast<int>(std::ceil(engine.getTailSeconds(mode, rootFrequency, resonance, numStages) * sampleRate));
+
+    // The second impulse lands a few blocks after the engine should have gone idle
+    const auto secondImpulse = tailSamples + 4 * maxBlockSize;
+    xynth::Stimulus stimulus { "idle", { numChannels, secondImpulse + static_cast<int>(sampleRate / 2) }, { { 0, rootFrequency * std::pow(2.f, 1.f / 12.f) } } };
+    stimulus.audio.clear();
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        stimulus.audio.setSample(channel, 0, 1.f);
+        stimulus.audio.setSample(channel, secondImpulse, 1.f);
+    }
+
+    // Against the engine itself rather than the reference, whose oscillators
+    // drift apart from the engine's over a stimulus this long
+    const auto expected = renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 0);
+    auto wentIdle = false;
+    const auto output = renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 0, &wentIdle);
+
+    const auto maxError = getMaxError(expected, output);
+    report.check("idle/" + describe(sampleRate, numHarmonics, numStages),
+                 wentIdle && maxError <= engineTolerance,
+                 juce::String(wentIdle ? "went idle" : "never idle") + ", max " + formatDecibels(maxError));
+}
+
+void checkReset(Report& report, const xynth::Stimulus& stimulus, double sampleRate)
+{
+    constexpr int numHarmonics = 24, numStages = 2;
+    constexpr auto mode = HarmonicEngine::Mode::PerHarmonicHilbert;
+
+    // As FileRenderer does between files: a silent file long enough to go idle in, then reset()
+    auto wentIdle = false;
+    const auto afterSilence = [&](HarmonicEngine& engine)
+    {
+        const auto tailSeconds = engine.getTailSeconds(mode, rootFrequency, resonance, numStages);
+        xynth::Stimulus silence { "silence", { numChannels, static_cast<int>((tailSeconds + 0.1) * sampleRate) }, { { 0, rootFrequency * 1.5f } } };
+        silence.audio.clear();
+
+        renderInBlocks(silence, [&](juce::AudioBuffer<float>& buffer, int start)
+        {
+            for (int h = 0; h < numHarmonics; ++h)
+                engine.setShiftFrequency(h, silence.getShift(h, start, rootFrequency));
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            engine.process(block, rootFrequency, resonance, numHarmonics, numStages);
+            wentIdle = wentIdle || engine.isIdle();
+        });
+
+        engine.reset();
+    };
+
+    auto idling = false;
+    const auto expected = renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 0, &idling);
+    const auto output = renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 0, &idling, afterSilence);
+
+    const auto maxError = getMaxError(expected, output);
+    report.check("reset/" + stimulus.name + " " + describe(sampleRate, numHarmonics, numStages),
+                 wentIdle && std::isinf(maxError),
+                 juce::String(wentIdle ? "went idle" : "never idle") + ", max " + formatDecibels(maxError));
+}
+
+void checkGovernor(Report& report, double sampleRate)
+{
+    using xynth::QualityGovernor;
+    const QualityGovernor::Settings requested { 64, 4, HarmonicEngine::Mode::PerHarmonicHilbert };
+    const auto fadeStep = 1.f / static_cast<float>(juce::roundToInt(QualityGovernor::fadeSeconds * sampleRate));
+
+    // Fades longer than a block, and one that doesn't divide them evenly
+    for (const auto blockSize : { 1, 37, 64, 128 })
+    {
+        QualityGovernor governor;
+        governor.prepare(sampleRate);
+
+        // A constant input, so the output is the governor's gain. Overloaded until
+        // the level changes, then idle for long enough to see the fade in end.
+        std::vector<float> gains;
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        const auto numBlocks = static_cast<int>(sampleRate * 0.5) / blockSize;
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            const auto overloaded = governor.getLevel() == 0;
+            governor.begin(requested, true);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                juce::FloatVectorOperations::fill(buffer.getWritePointer(channel), 1.f, blockSize);
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            governor.end(block, overloaded ? 2.0 * blockSize / sampleRate : 0.0);
+            gains.insert(gains.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize);
+        }
+
+        // The fade out has to reach silence before anything rises again
+        auto maxStep = 0.f;
+        auto roseEarly = false, fadedOut = false;
+        for (size_t i = 1; i < gains.size(); ++i)
+        {
+            maxStep = juce::jmax(maxStep, std::abs(gains[i] - gains[i - 1]));
+            fadedOut = fadedOut || gains[i] == 0.f;
+            roseEarly = roseEarly || (! fadedOut && gains[i] > gains[i - 1]);
+        }
+
+        report.check("governor/block=" + juce::String(blockSize) + " " + juce::String(juce::roundToInt(sampleRate / 1000.0)) + "k",
+                     governor.getLevel() == 1 && fadedOut && ! roseEarly && maxStep <= fadeStep * 1.01f,
+                     "level " + juce::String(governor.getLevel()) + (roseEarly ? ", rose during the fade out" : "")
+                       + ", max step " + juce::String(maxStep / fadeStep, 2) + " fade steps");
+    }
+}
+
+void checkMix(Report& report, const xynth::Stimulus& stimulus, double sampleRate)
+{
+    constexpr int numHarmonics = 24, numAudible = 9, numStages = 2;
+    const auto name = stimulus.name + " " + describe(sampleRate, numHarmonics, numStages);
+
+    for (const auto mode : { HarmonicEngine::Mode::PerHarmonicHilbert, HarmonicEngine::Mode::SharedAnalytic })
+    {
+        const auto modeName = juce::String(mode == HarmonicEngine::Mode::SharedAnalytic ? "shared analytic/" : "bandpass/");
+        const auto unity = renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 0);
+
+        auto mixAll = [&](float gain, float pan)
+        {
+            return renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 0, nullptr, [=](HarmonicEngine& engine)
+            {
+                for (int h = 0; h < numHarmonics; ++h)
+                    engine.setHarmonicMix(h, gain, pan);
+            });
+        };
+
+        // Everything after the gains is linear, so half the gain is half the output
+        auto expected = unity;
+        expected.applyGain(0.5f);
+        const auto gainError = getMaxError(expected, mixAll(0.5f, 0.f));
+        report.check("mix/gain " + modeName + name, gainError <= oracleTolerance, formatDecibels(gainError));
+
+        // Muted harmonics leave the same output as never having them
+        const auto fewer = renderEngine(stimulus, sampleRate, numAudible, numStages, mode, 0);
+        const auto muted = renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 0, nullptr, [](HarmonicEngine& engine)
+        {
+            for (int h = numAudible; h < numHarmonics; ++h)
+                engine.setHarmonicMix(h, 0.f);
+        });
+        const auto muteError = getMaxError(fewer, muted);
+        report.check("mix/mute " + modeName + name, muteError <= oracleTolerance, formatDecibels(muteError));
+
+        // Hard panned, one channel gets both and the other nothing
+        for (const auto pan : { -1.f, 1.f })
+        {
+            const auto side = pan < 0.f ? 0 : 1;
+            expected.makeCopyOf(unity);
+            expected.addFrom(side, 0, unity, 1 - side, 0, unity.getNumSamples());
+            expected.clear(1 - side, 0, unity.getNumSamples());
+
+            const auto panError = getMaxError(expected, mixAll(1.f, pan));
+            report.check("mix/pan " + juce::String(pan < 0.f ? "left " : "right ") + modeName + name,
+                         panError <= oracleTolerance, formatDecibels(panError));
+        }
+    }
+}
+
+void checkInstructionSets(Report& report, const xynth::Stimulus& stimulus, double sampleRate, int numHarmonics, int numStages)
+{
+    using xynth::SIMDKernels;
+
+    const auto reference = renderReference(stimulus, sampleRate, numHarmonics, numStages);
+    const auto current = SIMDKernels::get().instructionSet;
+
+    for (int set = 0; set < static_cast<int>(SIMDKernels::InstructionSet::numInstructionSets); ++set)
+    {
+        if (! SIMDKernels::use(static_cast<SIMDKernels::InstructionSet>(set)))
+            continue;
+
+        for (const auto mode : { HarmonicEngine::Mode::PerHarmonicHilbert, HarmonicEngine::Mode::SharedAnalytic })
+        {
+            const auto output = renderEngine(stimulus, sampleRate, numHarmonics, numStages, mode, 0);
+            const auto maxError = getMaxError(reference, output);
+            const auto spectralError = getSpectralError(reference, output);
+            report.check("isa/" + juce::String(SIMDKernels::get().name)
+                           + (mode == HarmonicEngine::Mode::SharedAnalytic ? " shared analytic/" : " bandpass/")
+                           + stimulus.name + " " + describe(sampleRate, numHarmonics, numStages),
+                         maxError <= engineTolerance && spectralError <= spectralTolerance,
+                         "max " + formatDecibels(maxError) + ", spectral " + formatDecibels(spectralError));
+        }
+    }
+
+    SIMDKernels::use(current);
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::FloatVectorOperations::disableDenormalisedNumberSupport();
+
+    Report report;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (juce::String(argv[i]) == "--verbose")
+        {
+            report.verbose = true;
+        }
+        else if (juce::String(argv[i]) == "--isa" && i + 1 < argc)
+        {
+            const auto* kernels = xynth::SIMDKernels::find(argv[++i]);
+            if (kernels == nullptr || ! xynth::SIMDKernels::use(kernels->instructionSet))
+            {
+                std::cerr << "instruction set not available: " << argv[i] << std::endl;
+                return skippedExitCode;
+            }
+        }
+        else
+        {
+            std::cerr << "usage: ModalShiftValidate [--verbose] [--isa name]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Enough harmonics to fill several groups, and one case that isn't a multiple of the SIMD width
+    const std::tuple<double, int, int> configurations[] {
+        { 48000.0, 1, 1 },
+        { 48000.0, 24, 2 },
+        { 48000.0, 77, 4 },
+        { 96000.0, 128, 4 }
+    };
+
+    for (const auto sampleRate : { 48000.0, 96000.0 })
+    {
+        const auto stimuli = xynth::makeStimuli(sampleRate, static_cast<int>(sampleRate / 2), numChannels, rootFrequency);
+        checkHilbert(report, stimuli, sampleRate);
+        checkBiquadBank(report, stimuli[2] /* noise */, sampleRate, 64, 4);
+
+        for (const auto& [configurationRate, numHarmonics, numStages] : configurations)
+            if (configurationRate == sampleRate)
+                checkEngine(report, stimuli, sampleRate, numHarmonics, numStages);
+
+        checkIdle(report, sampleRate);
+        checkReset(report, stimuli[2] /* noise */, sampleRate);
+        checkGovernor(report, sampleRate);
+        checkMix(report, stimuli[2] /* noise */, sampleRate);
+    }
+
+    // Every set, whichever one the rest ran with
+    const auto stimuli = xynth::makeStimuli(48000.0, 24000, numChannels, rootFrequency);
+    checkInstructionSets(report, stimuli[2] /* noise */, 48000.0, 77, 4);
+
+    std::cout << report.numPassed << " passed, " << report.numFailed << " failed" << std::endl;
+    return report.numFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    ReferenceEngine.cpp
+    Created: 19 Oct 2026 1:47:03pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "ReferenceEngine.h"
+
+namespace xynth
+{
+namespace reference
+{
+
+void Hilbert::prepare(double sampleRate, int numChannels, float passbandGain)
+{
+    Coeffs coeffs;
+
+    const float freqFactor = std::min<float>(0.46f, 20000.f / float(sampleRate));
+    direct = coeffs.direct * 2.f * passbandGain * freqFactor;
+
+    for (int i = 0; i < order; ++i)
+    {
+        const Complex coeff = coeffs.coeffs[i] * freqFactor * passbandGain;
+        coeffsReal[i] = coeff.real();
+        coeffsImag[i] = coeff.imag();
+
+        const Complex pole = std::exp(coeffs.poles[i] * freqFactor);
+        polesReal[i] = pole.real();
+        polesImag[i] = pole.imag();
+    }
+
+    states.resize(static_cast<size_t>(numChannels));
+    reset();
+}
+
+void Hilbert::reset() noexcept
+{
+    for (auto& state : states)
+        state = State();
+}
+
+Hilbert::Complex Hilbert::processSample(Complex sample, int channel) noexcept
+{
+    const auto state = states[static_cast<size_t>(channel)];
+    State newState;
+
+    for (int i = 0; i < order; ++i)
+        newState.real[i] = state.real[i] * polesReal[i] - state.imag[i] * polesImag[i]
+                         + sample.real() * coeffsReal[i] - sample.imag() * coeffsImag[i];
+
+    for (int i = 0; i < order; ++i)
+        newState.imag[i] = state.real[i] * polesImag[i] + state.imag[i] * polesReal[i]
+                         + sample.real() * coeffsImag[i] + sample.imag() * coeffsReal[i];
+
+    states[static_cast<size_t>(channel)] = newState;
+
+    float resultReal = sample.real() * direct;
+    for (int i = 0; i < order; ++i)
+        resultReal += newState.real[i];
+
+    float resultImag = sample.imag() * direct;
+    for (int i = 0; i < order; ++i)
+        resultImag += newState.imag[i];
+
+    return { resultReal, resultImag };
+}
+
+//==============================================================================
+void Engine::prepare(const juce::dsp::ProcessSpec& newSpec, int maxHarmonics)
+{
+    spec = newSpec;
+    const auto numChannels = static_cast<int>(spec.numChannels);
+
+    harmonics.resize(static_cast<size_t>(maxHarmonics));
+    for (auto& harmonic : harmonics)
+    {
+        harmonic.filters.resize(static_cast<size_t>(numChannels));
+        harmonic.hilbert.prepare(spec.sampleRate, numChannels);
+        harmonic.antialiasing.prepare(spec.sampleRate, numChannels, 1.f);
+    }
+
+    input.setSize(numChannels, static_cast<int>(spec.maximumBlockSize));
+    reset();
+}
+
+void Engine::reset() noexcept
+{
+    for (auto& harmonic : harmonics)
+    {
+        for (auto& cascade : harmonic.filters)
+            for (auto& filter : cascade)
+                filter.reset();
+
+        harmonic.hilbert.reset();
+        harmonic.antialiasing.reset();
+        harmonic.phase = 0.0;
+    }
+}
+
+void Engine::setShiftFrequency(int harmonic, float frequency) noexcept
+{
+    harmonics[static_cast<size_t>(harmonic)].frequency = frequency;
+}
+
+void Engine::process(juce::AudioBuffer<float>& buffer, float rootFrequency, float resonance,
+                     int numHarmonics, int numStages) noexcept
+{
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(spec.numChannels));
+    const auto numSamples = buffer.getNumSamples();
+    jassert(numSamples <= input.getNumSamples());
+
+    const auto maxPossibleHarmonics = static_cast<int>(spec.sampleRate / (2.0f * rootFrequency));
+    numHarmonics = juce::jmin(numHarmonics, maxPossibleHarmonics, static_cast<int>(harmonics.size()));
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        input.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+        buffer.clear(channel, 0, numSamples);
+    }
+
+    for (int h = 0; h < numHarmonics; ++h)
+    {
+        auto& harmonic = harmonics[static_cast<size_t>(h)];
+        const auto coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass(spec.sampleRate,
+                                                                                    rootFrequency * static_cast<float>(h + 1),
+                                                                                    resonance);
+        const auto phaseDelta = juce::MathConstants<double>::twoPi * harmonic.frequency / spec.sampleRate;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto& cascade = harmonic.filters[static_cast<size_t>(channel)];
+            for (int stage = 0; stage < numStages; ++stage)
+                cascade[static_cast<size_t>(stage)].coefficients = coefficients;
+
+            const auto* in = input.getReadPointer(channel);
+            auto* out = buffer.getWritePointer(channel);
+            auto phase = harmonic.phase;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto sample = in[i];
+                for (int stage = 0; stage < numStages; ++stage)
+                    sample = cascade[static_cast<size_t>(stage)].processSample(sample);
+
+                const auto analytic = harmonic.hilbert.processSample(Complex(sample), channel);
+                const Complex phasor(std::polar(1.0, phase));
+                out[i] += harmonic.antialiasing.processSample(analytic * phasor, channel).real();
+                phase += phaseDelta;
+            }
+
+            // As IIR::Filter::process does at the end of every block
+            for (int stage = 0; stage < numStages; ++stage)
+                cascade[static_cast<size_t>(stage)].snapToZero();
+        }
+
+        harmonic.phase = std::fmod(harmonic.phase + phaseDelta * numSamples, juce::MathConstants<double>::twoPi);
+    }
+}
+
+} // namespace reference
+} // namespace xynth
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    ReferenceEngine.h
+    Created: 19 Oct 2026 1:47:03pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Vendor/hilbert-iir/hilbert.h"
+
+namespace xynth
+{
+namespace reference
+{
+
+// Frozen, scalar copies of the original processing, kept here so that
+// optimising the real classes can never change what they are checked against.
+// Nothing in here should be "improved"; it only has to stay obviously right.
+
+// The original HilbertProcessor::processSample, one sample at a time
+class Hilbert
+{
+public:
+    using Complex = std::complex<float>;
+    using Coeffs = signalsmith::hilbert::HilbertIIRCoeffs<float>;
+    static constexpr int order = Coeffs::order;
+
+public:
+    Hilbert() = default;
+
+    void prepare(double sampleRate, int numChannels, float passbandGain = 2.f);
+    void reset() noexcept;
+
+    Complex processSample(Complex sample, int channel) noexcept;
+
+private:
+    using Array = std::array<float, order>;
+    struct State
+    {
+        Array real {}, imag {};
+    };
+
+    Array coeffsReal {}, coeffsImag {}, polesReal {}, polesImag {};
+    std::vector<State> states;
+    float direct = 0.f;
+
+};
+
+// The original processBlock: for every harmonic and channel, a cascade of
+// juce::dsp::IIR::Filter bandpasses, then a Hilbert filter, a std::polar
+// oscillator and an anti-aliasing filter of its own, summed into the output.
+// The oscillator phase is kept in double so the reference is never the
+// noisiest side of a comparison.
+class Engine
+{
+public:
+    using Complex = Hilbert::Complex;
+    static constexpr int maxStages = 4;
+
+public:
+    Engine() = default;
+
+    void prepare(const juce::dsp::ProcessSpec& spec, int maxHarmonics);
+    void reset() noexcept;
+
+    void setShiftFrequency(int harmonic, float frequency) noexcept;
+
+    void process(juce::AudioBuffer<float>& buffer, float rootFrequency, float resonance,
+                 int numHarmonics, int numStages) noexcept;
+
+private:
+    struct Harmonic
+    {
+        std::vector<std::array<juce::dsp::IIR::Filter<float>, maxStages>> filters;
+        Hilbert hilbert, antialiasing;
+        double phase = 0.0;
+        float frequency = 0.f;
+    };
+
+    juce::dsp::ProcessSpec spec { 44100.0, 0, 0 };
+    std::vector<Harmonic> harmonics;
+    juce::AudioBuffer<float> input;
+
+};
+
+} // namespace reference
+} // namespace xynth
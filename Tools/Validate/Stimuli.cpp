@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    Stimuli.cpp
+    Created: 19 Oct 2026 1:47:03pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#include "Stimuli.h"
+
+namespace xynth
+{
+
+namespace
+{
+
+float semitonesAbove(float frequency, float semitones)
+{
+    return frequency * std::pow(2.f, semitones / 12.f);
+}
+
+void fillNoise(juce::AudioBuffer<float>& audio, juce::int64 seed, float gain)
+{
+    juce::Random random(seed);
+    for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+        for (int i = 0; i < audio.getNumSamples(); ++i)
+            audio.setSample(channel, i, (random.nextFloat() * 2.f - 1.f) * gain);
+}
+
+} // namespace
+
+float Stimulus::getShift(int harmonic, int startSample, float rootFrequency) const noexcept
+{
+    auto noteFrequency = rootFrequency;
+    for (const auto& note : notes)
+        if (note.startSample <= startSample)
+            noteFrequency = note.noteFrequency;
+
+    return (noteFrequency - rootFrequency) * static_cast<float>(harmonic + 1);
+}
+
+std::vector<Stimulus> makeStimuli(double sampleRate, int numSamples, int numChannels, float rootFrequency)
+{
+    std::vector<Stimulus> stimuli;
+
+    // A semitone up: a different shift for every harmonic
+    const std::vector<Stimulus::NoteChange> fixedNote { { 0, semitonesAbove(rootFrequency, 1.f) } };
+
+    {
+        Stimulus impulses { "impulses", { numChannels, numSamples }, fixedNote };
+        impulses.audio.clear();
+        for (int i = 0; i < numSamples; i += numSamples / 4)
+            for (int channel = 0; channel < numChannels; ++channel)
+                impulses.audio.setSample(channel, i, 1.f);
+        stimuli.push_back(std::move(impulses));
+    }
+
+    {
+        // 20 Hz to 0.45 fs, the right channel a quarter of the way behind the left
+        Stimulus sweep { "sweep", { numChannels, numSamples }, fixedNote };
+        const auto startFrequency = 20.0;
+        const auto endFrequency = 0.45 * sampleRate;
+        const auto duration = numSamples / sampleRate;
+        const auto rate = std::log(endFrequency / startFrequency);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto t = std::fmod(i / sampleRate + channel * duration * 0.25, duration);
+                const auto phase = juce::MathConstants<double>::twoPi * startFrequency * duration / rate
+                                 * (std::exp(t * rate / duration) - 1.0);
+                sweep.audio.setSample(channel, i, static_cast<float>(0.5 * std::sin(phase)));
+            }
+        }
+        stimuli.push_back(std::move(sweep));
+    }
+
+    {
+        Stimulus noise { "noise", { numChannels, numSamples }, fixedNote };
+        fillNoise(noise.audio, 1, 0.25f);
+        stimuli.push_back(std::move(noise));
+    }
+
+    {
+        // Note changes land mid-block, as MIDI does, and are picked up at the next block
+        Stimulus sequence { "midi sequence", { numChannels, numSamples }, {} };
+        fillNoise(sequence.audio, 2, 0.25f);
+
+        const float semitones[] = { 0.f, 3.f, -5.f, 7.f, 12.f, -12.f, 0.5f };
+        const auto step = numSamples / static_cast<int>(std::size(semitones));
+        for (size_t i = 0; i < std::size(semitones); ++i)
+            sequence.notes.push_back({ static_cast<int>(i) * step + 101, semitonesAbove(rootFrequency, semitones[i]) });
+
+        stimuli.push_back(std::move(sequence));
+    }
+
+    return stimuli;
+}
+
+} // namespace xynth
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    Stimuli.h
+    Created: 19 Oct 2026 1:47:03pm
+    Author:  q
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace xynth
+{
+
+// A fixed test signal plus the shift amounts to play it with. Everything is
+// generated from fixed seeds, so the same stimulus is rendered on every run.
+struct Stimulus
+{
+    // From startSample on, harmonic h is shifted by (noteFrequency - root) * (h + 1),
+    // i.e. its partials are retuned onto the harmonics of the note
+    struct NoteChange
+    {
+        int startSample;
+        float noteFrequency;
+    };
+
+    juce::String name;
+    juce::AudioBuffer<float> audio;
+    std::vector<NoteChange> notes;
+
+    // The shift for a harmonic at the start of a block beginning at startSample
+    float getShift(int harmonic, int startSample, float rootFrequency) const noexcept;
+};
+
+// Impulses, a log sweep, white noise, and noise with a sequence of MIDI-style note changes
+std::vector<Stimulus> makeStimuli(double sampleRate, int numSamples, int numChannels, float rootFrequency);
+
+}